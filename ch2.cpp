@@ -209,17 +209,18 @@ bool isInRange(int value, int min, int max) {
     return value >= min && value <= max;
 }
 
-// Function to compute power iteratively
+// Function to compute power by squaring: O(log |exponent|), negative exponents allowed
 double power(double base, int exponent) {
-    if (exponent < 0) {
-        std::cerr << "Error: Negative exponent not supported\n";
-        return 0.0;
-    }
+    long long n = exponent; // widen so -INT_MIN does not overflow
+    bool negative = n < 0;
+    if (negative) n = -n;
     double result = 1.0;
-    for (int i = 0; i < exponent; ++i) {
-        result *= base;
+    while (n > 0) {
+        if (n & 1) result *= base;
+        base *= base;
+        n >>= 1;
     }
-    return result;
+    return negative ? 1.0 / result : result;
 }
 
 // Function to reverse an array in-place
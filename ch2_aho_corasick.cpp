@@ -0,0 +1,476 @@
+// File: ch2_aho_corasick.cpp
+// Purpose: Adds a multi-keyword streaming matcher to the ch2.cpp StringUtils namespace, so a
+//          log stream can be scanned for tens of thousands of keywords in one pass instead of
+//          one std::string::find() per keyword (roadmap: LeetCode #1032, Stream of Characters).
+//          Build: g++ -std=c++17 -O2 ch2_aho_corasick.cpp -o ch2_aho_corasick
+
+// === Topic Overview ===
+// This program covers:
+// - Aho-Corasick: a trie of all keywords plus failure links, flattened into one dense
+//   transition table so every input byte costs exactly one table load.
+// - Alphabet compression: bytes that no keyword uses share one column, so a row holds
+//   ~40 entries for typical keywords instead of 256.
+// - Case folding by the same rule as toUpperCase() (std::toupper), built into the
+//   byte-to-column map, so the text is never copied or converted.
+// - A streaming API: the automaton state and byte offset live in a small StreamState, so
+//   a match split across two buffers is still found.
+// - A SIMD prefilter: while the automaton is at the root, blocks of 16 bytes that contain
+//   no possible first byte of a keyword are skipped with a few vector compares.
+
+// === Significance in Computer Science ===
+// Searching for k keywords one at a time costs k passes over the text. Aho-Corasick
+// (1975) finds every occurrence of every keyword in a single left-to-right pass, in time
+// linear in the text plus the number of matches. It is the core of fgrep, intrusion
+// detection systems and virus scanners.
+
+// === Simulated Header File: string_utils.hpp ===
+#ifndef STRING_UTILS_HPP
+#define STRING_UTILS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace StringUtils {
+// Forward declarations
+std::string toUpperCase(const std::string& input);
+
+// One occurrence: keyword index, and the stream offset one past its last byte
+struct KeywordMatch {
+    int keyword;
+    uint64_t end;
+};
+
+// Aho-Corasick automaton over a fixed keyword set; immutable once built, so one matcher
+// can serve any number of streams and threads
+class KeywordMatcher {
+public:
+    // Where a stream left off; start every new stream with a default-constructed one
+    struct StreamState {
+        uint32_t state = 0;
+        uint64_t offset = 0;
+    };
+
+    explicit KeywordMatcher(const std::vector<std::string>& keywords, bool ignoreCase = true);
+
+    // Feed the next piece of a stream; onMatch(const KeywordMatch&) runs for every keyword
+    // occurrence that ends inside this piece
+    template <typename Fn>
+    void scan(StreamState& stream, const char* data, size_t length, Fn onMatch) const;
+    std::vector<KeywordMatch> findAll(const std::string& text) const;
+
+    const std::string& keyword(int index) const { return keywords[index]; }
+    size_t states() const { return stateCount; }
+    size_t tableBytes() const { return table.size() * sizeof(uint32_t); }
+    bool prefilterEnabled() const { return startByteCount > 0; }
+
+private:
+    size_t firstStartByte(const unsigned char* data, size_t begin, size_t end) const;
+    template <typename Fn>
+    void report(uint32_t state, uint64_t end, Fn& onMatch) const;
+
+    static const uint32_t MATCH_FLAG = 0x80000000u;
+
+    std::vector<std::string> keywords;
+    uint16_t column[256];           // byte -> table column, case folding included
+    bool startsKeyword[256];        // bytes the root has a real edge for
+    unsigned char startBytes[8];    // the same set, if it is small enough for SIMD
+    int startByteCount;             // 0 disables the prefilter
+    uint32_t stride;                // columns per row
+    size_t stateCount;
+    // table[s * stride + column] = next * stride, plus MATCH_FLAG if next reports anything
+    std::vector<uint32_t> table;
+    std::vector<uint32_t> outputBegin; // CSR list of keywords ending exactly at each state
+    std::vector<int> outputKeywords;
+    std::vector<uint32_t> dictionaryLink; // nearest proper suffix state with output, 0 if none
+};
+
+template <typename Fn>
+void KeywordMatcher::report(uint32_t state, uint64_t end, Fn& onMatch) const {
+    while (state != 0) {
+        for (uint32_t i = outputBegin[state]; i < outputBegin[state + 1]; ++i) {
+            onMatch(KeywordMatch{outputKeywords[i], end});
+        }
+        state = dictionaryLink[state];
+    }
+}
+
+template <typename Fn>
+void KeywordMatcher::scan(StreamState& stream, const char* data, size_t length,
+                          Fn onMatch) const {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    const uint32_t* transitions = table.data();
+    uint32_t current = stream.state;
+    size_t i = 0;
+    while (i < length) {
+        if (current == 0 && startByteCount > 0) {
+            i = firstStartByte(bytes, i, length);
+            if (i == length) break;
+        }
+        const uint32_t next = transitions[current + column[bytes[i]]];
+        current = next & ~MATCH_FLAG;
+        ++i;
+        if (next & MATCH_FLAG) report(current / stride, stream.offset + i, onMatch);
+    }
+    stream.state = current;
+    stream.offset += length;
+}
+} // namespace StringUtils
+
+#endif // STRING_UTILS_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cctype>
+#include <random>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// === Preprocessor Directives ===
+#define ABSENT 0xFFFFFFFFu
+#define MAX_SIMD_START_BYTES 8
+#define SIMD_BLOCK 16
+
+// === Function Definitions: StringUtils (from ch2.cpp) ===
+namespace StringUtils {
+// Convert string to uppercase
+std::string toUpperCase(const std::string& input) {
+    std::string result = input;
+    for (char& c : result) {
+        c = std::toupper(c);
+    }
+    return result;
+}
+} // namespace StringUtils
+
+// === Function Definitions: KeywordMatcher ===
+namespace StringUtils {
+KeywordMatcher::KeywordMatcher(const std::vector<std::string>& keywordList, bool ignoreCase)
+    : keywords(keywordList), startByteCount(0), stride(1), stateCount(1) {
+    // Column 0 is every byte no keyword uses; each folded byte a keyword uses gets its own
+    unsigned char fold[256];
+    uint16_t foldedColumn[256] = {};
+    for (int b = 0; b < 256; ++b) {
+        fold[b] = static_cast<unsigned char>(ignoreCase ? std::toupper(b) : b);
+    }
+    for (const std::string& word : keywords) {
+        for (unsigned char c : word) {
+            if (foldedColumn[fold[c]] == 0) foldedColumn[fold[c]] = static_cast<uint16_t>(stride++);
+        }
+    }
+    for (int b = 0; b < 256; ++b) column[b] = foldedColumn[fold[b]];
+
+    // Trie with ABSENT for missing edges; state indices, not yet multiplied by stride
+    std::vector<uint32_t> trie(stride, ABSENT);
+    std::vector<std::vector<int>> ending(1);
+    for (size_t k = 0; k < keywords.size(); ++k) {
+        if (keywords[k].empty()) {
+            std::cerr << "Error: Empty keyword ignored\n";
+            continue;
+        }
+        uint32_t state = 0;
+        for (unsigned char c : keywords[k]) {
+            uint32_t& edge = trie[state * stride + column[c]];
+            if (edge == ABSENT) {
+                edge = static_cast<uint32_t>(stateCount++);
+                trie.resize(stateCount * stride, ABSENT);
+                ending.emplace_back();
+            }
+            state = trie[state * stride + column[c]]; // re-read: resize may have moved `edge`
+        }
+        ending[state].push_back(static_cast<int>(k));
+    }
+    if (stateCount * stride >= MATCH_FLAG) {
+        std::cerr << "Error: Keyword set too large for a 31-bit transition table\n";
+        keywords.clear();
+        std::fill(column, column + 256, 0);
+        stride = 1;
+        stateCount = 1;
+        trie.assign(1, ABSENT);
+        ending.assign(1, std::vector<int>());
+    }
+
+    // Breadth-first: a state's failure link is shallower, so its row is already complete
+    // and missing edges can be copied from it
+    std::vector<uint32_t> failure(stateCount, 0);
+    dictionaryLink.assign(stateCount, 0);
+    std::vector<uint32_t> order;
+    order.reserve(stateCount);
+    for (uint32_t c = 0; c < stride; ++c) {
+        uint32_t& edge = trie[c];
+        if (edge == ABSENT) edge = 0;
+        else order.push_back(edge);
+    }
+    for (size_t head = 0; head < order.size(); ++head) {
+        const uint32_t state = order[head];
+        const uint32_t fail = failure[state];
+        dictionaryLink[state] = ending[fail].empty() ? dictionaryLink[fail] : fail;
+        for (uint32_t c = 0; c < stride; ++c) {
+            uint32_t& edge = trie[state * stride + c];
+            if (edge == ABSENT) {
+                edge = trie[fail * stride + c];
+            } else {
+                failure[edge] = trie[fail * stride + c];
+                order.push_back(edge);
+            }
+        }
+    }
+
+    outputBegin.assign(stateCount + 1, 0);
+    for (size_t s = 0; s < stateCount; ++s) {
+        outputBegin[s + 1] = outputBegin[s] + static_cast<uint32_t>(ending[s].size());
+        outputKeywords.insert(outputKeywords.end(), ending[s].begin(), ending[s].end());
+    }
+    table.resize(trie.size());
+    for (size_t i = 0; i < trie.size(); ++i) {
+        const uint32_t next = trie[i];
+        const bool reports = !ending[next].empty() || dictionaryLink[next] != 0;
+        table[i] = next * stride | (reports ? MATCH_FLAG : 0);
+    }
+
+    // Prefilter: which raw bytes take the root somewhere other than back to the root
+    int starts = 0;
+    for (int b = 0; b < 256; ++b) {
+        startsKeyword[b] = column[b] != 0 && trie[column[b]] != 0;
+        if (!startsKeyword[b]) continue;
+        if (starts < MAX_SIMD_START_BYTES) startBytes[starts] = static_cast<unsigned char>(b);
+        ++starts;
+    }
+    startByteCount = starts <= MAX_SIMD_START_BYTES ? starts : 0;
+}
+
+// Index of the first byte in [begin, end) that can start a keyword, or end
+size_t KeywordMatcher::firstStartByte(const unsigned char* data, size_t begin,
+                                      size_t end) const {
+    size_t i = begin;
+#if defined(__SSE2__)
+    for (; i + SIMD_BLOCK <= end; i += SIMD_BLOCK) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hit = _mm_cmpeq_epi8(block, _mm_set1_epi8(static_cast<char>(startBytes[0])));
+        for (int j = 1; j < startByteCount; ++j) {
+            const __m128i needle = _mm_set1_epi8(static_cast<char>(startBytes[j]));
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, needle));
+        }
+        const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask != 0) return i + __builtin_ctz(mask);
+    }
+#elif defined(__ARM_NEON)
+    for (; i + SIMD_BLOCK <= end; i += SIMD_BLOCK) {
+        const uint8x16_t block = vld1q_u8(data + i);
+        uint8x16_t hit = vceqq_u8(block, vdupq_n_u8(startBytes[0]));
+        for (int j = 1; j < startByteCount; ++j) {
+            hit = vorrq_u8(hit, vceqq_u8(block, vdupq_n_u8(startBytes[j])));
+        }
+        // Narrow each 0xFF/0x00 byte to a nibble: a 64-bit mask with 4 bits per byte
+        const uint64_t mask =
+            vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hit), 4)), 0);
+        if (mask != 0) return i + __builtin_ctzll(mask) / 4;
+    }
+#endif
+    for (; i < end; ++i) {
+        if (startsKeyword[data[i]]) return i;
+    }
+    return end;
+}
+
+std::vector<KeywordMatch> KeywordMatcher::findAll(const std::string& text) const {
+    std::vector<KeywordMatch> matches;
+    StreamState stream;
+    scan(stream, text.data(), text.size(), [&](const KeywordMatch& m) { matches.push_back(m); });
+    return matches;
+}
+} // namespace StringUtils
+
+// === Utility Functions ===
+template <typename Fn>
+double millisecondsFor(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+std::string randomWord(int minLength, int maxLength, std::mt19937& rng) {
+    std::uniform_int_distribution<int> length(minLength, maxLength);
+    std::uniform_int_distribution<int> letter(0, 25);
+    std::string word(length(rng), 'a');
+    for (char& c : word) c = static_cast<char>('a' + letter(rng));
+    return word;
+}
+
+// Synthetic log lines, with a keyword planted in roughly one line in `plantEvery`
+std::string randomLog(size_t bytes, const std::vector<std::string>& plant, int plantEvery,
+                      std::mt19937& rng) {
+    static const char* levels[] = {"INFO", "DEBUG", "WARN"};
+    std::string log;
+    log.reserve(bytes + 128);
+    std::uniform_int_distribution<int> latency(1, 999);
+    for (size_t line = 0; log.size() < bytes; ++line) {
+        log += "2026-10-19T12:00:00 ";
+        log += levels[line % 3];
+        log += " svc=" + randomWord(4, 9, rng) + " user=" + randomWord(3, 8, rng);
+        log += " latency=" + std::to_string(latency(rng)) + "ms";
+        if (!plant.empty() && line % plantEvery == 0) {
+            log += " msg=" + plant[rng() % plant.size()];
+        }
+        log += "\n";
+    }
+    return log;
+}
+
+// Today's approach: uppercase the text, then one find() pass per keyword
+std::vector<StringUtils::KeywordMatch> findEachKeyword(const std::string& text,
+                                                       const std::vector<std::string>& keywords) {
+    std::vector<StringUtils::KeywordMatch> matches;
+    const std::string upper = StringUtils::toUpperCase(text);
+    for (size_t k = 0; k < keywords.size(); ++k) {
+        const std::string needle = StringUtils::toUpperCase(keywords[k]);
+        for (size_t pos = upper.find(needle); pos != std::string::npos;
+             pos = upper.find(needle, pos + 1)) {
+            matches.push_back({static_cast<int>(k), pos + needle.size()});
+        }
+    }
+    return matches;
+}
+
+void sortMatches(std::vector<StringUtils::KeywordMatch>& matches) {
+    std::sort(matches.begin(), matches.end(),
+              [](const StringUtils::KeywordMatch& a, const StringUtils::KeywordMatch& b) {
+                  return a.end != b.end ? a.end < b.end : a.keyword < b.keyword;
+              });
+}
+
+bool sameMatches(std::vector<StringUtils::KeywordMatch> a,
+                 std::vector<StringUtils::KeywordMatch> b) {
+    sortMatches(a);
+    sortMatches(b);
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].keyword != b[i].keyword || a[i].end != b[i].end) return false;
+    }
+    return true;
+}
+
+// Feed the text in random-sized pieces, as a socket or file reader would
+std::vector<StringUtils::KeywordMatch> scanInPieces(const StringUtils::KeywordMatcher& matcher,
+                                                    const std::string& text, int maxPiece,
+                                                    std::mt19937& rng) {
+    std::vector<StringUtils::KeywordMatch> matches;
+    StringUtils::KeywordMatcher::StreamState stream;
+    std::uniform_int_distribution<int> piece(1, maxPiece);
+    for (size_t pos = 0; pos < text.size();) {
+        const size_t length = std::min(text.size() - pos, static_cast<size_t>(piece(rng)));
+        matcher.scan(stream, text.data() + pos, length,
+                     [&](const StringUtils::KeywordMatch& m) { matches.push_back(m); });
+        pos += length;
+    }
+    return matches;
+}
+
+void benchmark(const char* label, const StringUtils::KeywordMatcher& matcher,
+               const std::string& text) {
+    size_t found = 0;
+    StringUtils::KeywordMatcher::StreamState stream;
+    const double ms = millisecondsFor([&] {
+        matcher.scan(stream, text.data(), text.size(),
+                     [&](const StringUtils::KeywordMatch&) { ++found; });
+    });
+    std::cout << label << ms << " ms, " << text.size() / ms / 1e6 << " GB/s, " << found
+              << " matches\n";
+}
+
+// === Program Design: Main Function ===
+int main(int argc, char* argv[]) {
+    const size_t megabytes = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 64;
+    const int keywordCount = argc > 2 ? std::atoi(argv[2]) : 20000;
+    std::mt19937 rng(35);
+    bool ok = true;
+
+    // Classic example: overlapping keywords, mixed case
+    StringUtils::KeywordMatcher classic({"he", "she", "his", "hers"});
+    std::cout << "keywords {he, she, his, hers} in \"uSHErs\":";
+    for (const StringUtils::KeywordMatch& m : classic.findAll("uSHErs")) {
+        const std::string& word = classic.keyword(m.keyword);
+        std::cout << " " << word << "@" << m.end - word.size();
+    }
+    std::cout << "\n";
+
+    // LeetCode #1032: one character at a time, true when some keyword ends here
+    StringUtils::KeywordMatcher checker({"cd", "f", "kl"});
+    StringUtils::KeywordMatcher::StreamState stream;
+    std::string answers;
+    for (char c : std::string("abcdefghijkl")) {
+        bool hit = false;
+        checker.scan(stream, &c, 1, [&](const StringUtils::KeywordMatch&) { hit = true; });
+        answers += hit ? 'T' : 'f';
+    }
+    std::cout << "stream of characters abcdefghijkl: " << answers << "\n";
+    ok = answers == "fffTfTfffffT";
+
+    // Correctness against one find() per keyword, whole buffer and streamed in pieces
+    for (int trial = 0; trial < 40 && ok; ++trial) {
+        std::vector<std::string> keywords;
+        for (int k = 0; k < 1 + trial * 5; ++k) {
+            keywords.push_back(randomWord(1, 1 + trial % 6, rng));
+        }
+        if (trial % 3 == 0) keywords.push_back(StringUtils::toUpperCase(keywords[0])); // duplicate
+        StringUtils::KeywordMatcher matcher(keywords);
+        std::string text = randomLog(20000, keywords, 3, rng);
+        std::vector<StringUtils::KeywordMatch> expected = findEachKeyword(text, keywords);
+        ok = sameMatches(matcher.findAll(text), expected) &&
+             sameMatches(scanInPieces(matcher, text, 1 + trial * 10, rng), expected);
+    }
+    std::cout << "matches repeated find(): " << (ok ? "yes" : "NO") << "\n";
+
+    // Throughput: a few rare keywords (prefilter on) and a large keyword set (prefilter off)
+    std::vector<std::string> alerts = {"QUOTA_EXCEEDED", "ZFS_FAULT", "XID_ERROR", "KERNEL_PANIC"};
+    std::vector<std::string> dictionary;
+    for (int k = 0; k < keywordCount; ++k) dictionary.push_back(randomWord(6, 12, rng));
+    std::string log = randomLog(megabytes << 20, alerts, 1000, rng);
+    std::cout << "\n=== " << megabytes << " MB log ===\n";
+
+    StringUtils::KeywordMatcher alertMatcher(alerts);
+    std::cout << alerts.size() << " keywords: " << alertMatcher.states() << " states, "
+              << alertMatcher.tableBytes() / 1024 << " KB table, prefilter "
+              << (alertMatcher.prefilterEnabled() ? "on" : "off") << "\n";
+    std::vector<StringUtils::KeywordMatch> viaFind;
+    const double findMs = millisecondsFor([&] { viaFind = findEachKeyword(log, alerts); });
+    std::cout << "  repeated find():    " << findMs << " ms, " << log.size() / findMs / 1e6
+              << " GB/s\n";
+    benchmark("  Aho-Corasick:       ", alertMatcher, log);
+    ok = ok && sameMatches(alertMatcher.findAll(log), viaFind);
+
+    StringUtils::KeywordMatcher dictionaryMatcher(dictionary);
+    std::cout << dictionary.size() << " keywords: " << dictionaryMatcher.states() << " states, "
+              << dictionaryMatcher.tableBytes() / (1 << 20) << " MB table, prefilter "
+              << (dictionaryMatcher.prefilterEnabled() ? "on" : "off") << "\n";
+    // find() per keyword is far too slow for the full log; time it on a 256 KB slice
+    const std::string slice = log.substr(0, 1 << 18);
+    const double sliceMs = millisecondsFor([&] { viaFind = findEachKeyword(slice, dictionary); });
+    std::cout << "  repeated find():    " << sliceMs << " ms for 256 KB, "
+              << slice.size() / sliceMs / 1e6 << " GB/s\n";
+    benchmark("  Aho-Corasick:       ", dictionaryMatcher, log);
+    ok = ok && sameMatches(dictionaryMatcher.findAll(slice), viaFind);
+
+    std::cout << "\nall results agree: " << (ok ? "yes" : "NO") << "\n";
+    return ok ? 0 : 1;
+}
+
+// === Program Design Notes ===
+// - Transitions are stored pre-multiplied by the row width, so the hot loop is one load,
+//   one mask and one add per byte; the top bit marks states that report a match.
+// - The prefilter only runs at the root, and only for up to 8 distinct first bytes (after
+//   case folding both cases count). Large keyword sets start with almost every letter,
+//   so it switches itself off and the table walk runs alone.
+// - Matches are reported by end offset; the start is end - keyword(k).size().
+// - Folding uses std::toupper in the "C" locale, exactly like toUpperCase(): ASCII letters
+//   only, other bytes are compared as-is.
+
+// === End of File ===
@@ -0,0 +1,868 @@
+// File: ch2_batch_server.cpp
+// Purpose: A long-running local server that exposes the ch2.cpp MathUtils/StringUtils
+//          functions over a Unix domain socket, plus a load generator that measures it.
+//          Build: g++ -std=c++17 -O2 -pthread ch2_batch_server.cpp -o ch2_batch_server
+
+// === Topic Overview ===
+// This program covers:
+// - Event loops: one epoll (Linux) or poll (elsewhere) loop drives every connection.
+// - Binary framing: every message is a fixed little header followed by a payload.
+// - Request coalescing: all requests that arrive in the same loop iteration ("tick") are
+//   grouped by operation and answered with one batched call per operation.
+// - Pipelining: a client may have many requests in flight on one connection; responses
+//   carry the request id so they can come back in any order.
+// - Measurement: the client reports p50/p99 latency and throughput.
+
+// === Significance in Computer Science ===
+// Calling a tiny function through a socket costs far more than the function itself. The
+// fix is to amortize: read everything that is ready, do the work in batches, and write
+// everything back with as few system calls as possible. The same idea shows up in
+// databases (group commit), network cards (interrupt coalescing) and GPUs (kernel batching).
+
+// === Usage ===
+//   ./ch2_batch_server server [socket_path]
+//   ./ch2_batch_server bench  [socket_path] [connections] [pipeline_depth] [requests]
+//   ./ch2_batch_server                       (starts a server in a child and benchmarks it)
+
+// === Simulated Header File: math_utils.hpp ===
+#ifndef MATH_UTILS_HPP
+#define MATH_UTILS_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace MathUtils {
+// Forward declarations
+double calculateAverage(double arr[], int size);
+bool isPrime(int n);
+// Batched versions: answer many calls at once
+void isPrimeBatch(const int32_t* values, int count, uint8_t* results);
+// out[i] = average of values[offsets[i] .. offsets[i] + counts[i]); every count must be > 0
+void calculateAverageBatch(const double* values, const uint32_t* offsets,
+                           const uint32_t* counts, int segments, double* out);
+} // namespace MathUtils
+
+#endif // MATH_UTILS_HPP
+
+// === Simulated Header File: string_utils.hpp ===
+#ifndef STRING_UTILS_HPP
+#define STRING_UTILS_HPP
+
+#include <string>
+
+namespace StringUtils {
+// Forward declarations
+std::string toUpperCase(const std::string& input);
+// Batched version: uppercase a buffer that holds many strings back to back
+void toUpperCaseInPlace(char* data, size_t length);
+} // namespace StringUtils
+
+#endif // STRING_UTILS_HPP
+
+// === Simulated Header File: batch_protocol.hpp ===
+#ifndef BATCH_PROTOCOL_HPP
+#define BATCH_PROTOCOL_HPP
+
+#include <cstdint>
+
+namespace BatchProtocol {
+// Request frame:  [u32 payload_length][u32 request_id][u8 opcode][payload...]
+// Response frame: [u32 payload_length][u32 request_id][u8 status][payload...]
+// Both ends run on the same machine, so integers are sent in host byte order.
+const size_t HEADER_SIZE = 9;
+const uint32_t MAX_PAYLOAD = 1 << 20;
+
+enum Opcode : uint8_t {
+    OP_IS_PRIME = 1,     // payload: i32 n                    -> u8 (0 or 1)
+    OP_TO_UPPER = 2,     // payload: raw bytes                -> raw bytes
+    OP_CALC_AVERAGE = 3  // payload: f64 values[]             -> f64 average
+};
+
+enum Status : uint8_t {
+    STATUS_OK = 0,
+    STATUS_BAD_REQUEST = 1
+};
+} // namespace BatchProtocol
+
+#endif // BATCH_PROTOCOL_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cctype>
+#include <cmath>
+#include <cerrno>
+#include <csignal>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#define DEFAULT_SOCKET_PATH "/tmp/ch2_batch_server.sock"
+#define MAX_EVENTS 256
+#define READ_CHUNK 65536
+#define READ_BUDGET (4 * READ_CHUNK) // bytes read from one client per tick
+#define OUTPUT_HIGH_WATER (1 << 22) // stop reading a client with this much unsent output
+#define OUTPUT_LOW_WATER (1 << 20) // ...and resume once it has drained below this
+#define AVERAGE_LANES 4 // averages computed side by side by calculateAverageBatch()
+
+// macOS has no MSG_NOSIGNAL; SIGPIPE is ignored at startup instead
+#ifdef MSG_NOSIGNAL
+#define MSG_NOSIGNAL_FLAG MSG_NOSIGNAL
+#else
+#define MSG_NOSIGNAL_FLAG 0
+#endif
+
+// === Function Definitions: MathUtils ===
+namespace MathUtils {
+// Calculate the average of an array of doubles
+double calculateAverage(double arr[], int size) {
+    if (size <= 0) {
+        std::cerr << "Error: Invalid array size\n";
+        return 0.0;
+    }
+    double sum = 0.0;
+    for (int i = 0; i < size; ++i) {
+        sum += arr[i];
+    }
+    return sum / size;
+}
+
+// Check if a number is prime
+bool isPrime(int n) {
+    if (n <= 1) return false;
+    for (int i = 2; i <= std::sqrt(n); ++i) {
+        if (n % i == 0) return false;
+    }
+    return true;
+}
+
+// Primes up to sqrt(INT_MAX), built once and reused by every batch
+static const std::vector<int32_t>& smallPrimes() {
+    static std::vector<int32_t> primes;
+    if (primes.empty()) {
+        const int limit = 46341; // ceil(sqrt(2^31 - 1))
+        std::vector<uint8_t> composite(limit + 1, 0);
+        for (int i = 2; i <= limit; ++i) {
+            if (composite[i]) continue;
+            primes.push_back(i);
+            for (long long j = 1LL * i * i; j <= limit; j += i) {
+                composite[j] = 1;
+            }
+        }
+    }
+    return primes;
+}
+
+// Check many numbers at once. Trial division only by primes (not every integer), which
+// is the batch's win over calling isPrime() in a loop.
+void isPrimeBatch(const int32_t* values, int count, uint8_t* results) {
+    const std::vector<int32_t>& primes = smallPrimes();
+    for (int k = 0; k < count; ++k) {
+        int32_t n = values[k];
+        uint8_t prime = n > 1;
+        for (size_t i = 0; prime && i < primes.size(); ++i) {
+            int32_t p = primes[i];
+            if (1LL * p * p > n) break;
+            if (n % p == 0) prime = 0;
+        }
+        results[k] = prime;
+    }
+}
+
+// Averages of many segments in one pass. Each lane holds a different segment and adds its
+// values in order, so every result is bit-identical to calculateAverage(); the lane loop
+// has no branches and is vectorized by the compiler.
+void calculateAverageBatch(const double* values, const uint32_t* offsets,
+                           const uint32_t* counts, int segments, double* out) {
+    for (int base = 0; base < segments; base += AVERAGE_LANES) {
+        const int lanes = std::min(AVERAGE_LANES, segments - base);
+        uint32_t laneOffset[AVERAGE_LANES], laneCount[AVERAGE_LANES];
+        uint32_t longest = 0;
+        for (int l = 0; l < AVERAGE_LANES; ++l) {
+            // Spare lanes repeat the last segment with a count of 0
+            laneOffset[l] = offsets[base + std::min(l, lanes - 1)];
+            laneCount[l] = l < lanes ? counts[base + l] : 0;
+            longest = std::max(longest, laneCount[l]);
+        }
+        double sum[AVERAGE_LANES] = {};
+        for (uint32_t j = 0; j < longest; ++j) {
+            for (int l = 0; l < AVERAGE_LANES; ++l) {
+                const bool active = j < laneCount[l];
+                const double v = values[laneOffset[l] + (active ? j : 0)];
+                sum[l] += active ? v : 0.0;
+            }
+        }
+        for (int l = 0; l < lanes; ++l) out[base + l] = sum[l] / laneCount[l];
+    }
+}
+} // namespace MathUtils
+
+// === Function Definitions: StringUtils ===
+namespace StringUtils {
+// Convert string to uppercase
+std::string toUpperCase(const std::string& input) {
+    std::string result = input;
+    for (char& c : result) {
+        c = std::toupper(c);
+    }
+    return result;
+}
+
+// Branch-free ASCII uppercase (same result as std::toupper in the "C" locale). The loop has
+// no data-dependent branches, so the compiler turns it into SIMD code.
+void toUpperCaseInPlace(char* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        unsigned char isLower = static_cast<unsigned char>(c - 'a') < 26;
+        data[i] = static_cast<char>(c - (isLower << 5));
+    }
+}
+} // namespace StringUtils
+
+// === Utility Functions: sockets ===
+namespace BatchProtocol {
+// Put a file descriptor into non-blocking mode
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// Fill a sockaddr_un for the given path
+bool makeAddress(const std::string& path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: Socket path too long\n";
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size());
+    return true;
+}
+
+// Append a frame header to a byte buffer
+void appendHeader(std::string& out, uint32_t length, uint32_t id, uint8_t code) {
+    char header[HEADER_SIZE];
+    std::memcpy(header, &length, 4);
+    std::memcpy(header + 4, &id, 4);
+    header[8] = static_cast<char>(code);
+    out.append(header, HEADER_SIZE);
+}
+} // namespace BatchProtocol
+
+// === Server ===
+namespace BatchServer {
+using namespace BatchProtocol;
+
+struct Connection {
+    int fd = -1;
+    std::string input;   // bytes read but not yet parsed
+    std::string output;  // responses waiting to be written
+    bool wantWrite = false;
+    bool wantRead = true;    // false while backpressure holds the client's reads
+    bool peerClosed = false; // EOF read: answer what was parsed, flush, then close
+    bool closed = false;
+};
+
+// A request waiting for the end of the tick, remembered by where its answer must go
+struct Pending {
+    int fd;
+    uint32_t id;
+    uint32_t offset; // where the payload starts in the op's shared buffer
+    uint32_t length;
+};
+
+// Everything collected during one tick, grouped by operation
+struct Tick {
+    std::vector<Pending> primeRequests;
+    std::vector<int32_t> primeValues;
+    std::vector<Pending> upperRequests;
+    std::string upperBytes;
+    std::vector<Pending> averageRequests;
+    std::vector<double> averageValues;
+
+    bool empty() const {
+        return primeRequests.empty() && upperRequests.empty() && averageRequests.empty();
+    }
+    void clear() {
+        primeRequests.clear();
+        primeValues.clear();
+        upperRequests.clear();
+        upperBytes.clear();
+        averageRequests.clear();
+        averageValues.clear();
+    }
+};
+
+// Thin wrapper so the loop reads the same with epoll or poll
+class EventLoop {
+public:
+    EventLoop() {
+#ifdef __linux__
+        epollFd = epoll_create1(0);
+#endif
+    }
+    ~EventLoop() {
+#ifdef __linux__
+        if (epollFd >= 0) close(epollFd);
+#endif
+    }
+    bool ok() const {
+#ifdef __linux__
+        return epollFd >= 0;
+#else
+        return true;
+#endif
+    }
+    void watch(int fd, bool writable, bool readable = true) {
+#ifdef __linux__
+        epoll_event ev{};
+        ev.events = (readable ? static_cast<uint32_t>(EPOLLIN) : 0u) |
+                    (writable ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev) != 0) {
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+        }
+#else
+        for (pollfd& p : fds) {
+            if (p.fd == fd) {
+                p.events = static_cast<short>((readable ? POLLIN : 0) | (writable ? POLLOUT : 0));
+                return;
+            }
+        }
+        fds.push_back({fd, static_cast<short>((readable ? POLLIN : 0) | (writable ? POLLOUT : 0)),
+                       0});
+#endif
+    }
+    void forget(int fd) {
+#ifdef __linux__
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+#else
+        fds.erase(std::remove_if(fds.begin(), fds.end(),
+                                 [fd](const pollfd& p) { return p.fd == fd; }),
+                  fds.end());
+#endif
+    }
+    // Wait for events; fills (fd, readable, writable) triples
+    int wait(std::vector<int>& readyFds, std::vector<uint8_t>& readable,
+             std::vector<uint8_t>& writable, int timeoutMs) {
+        readyFds.clear();
+        readable.clear();
+        writable.clear();
+#ifdef __linux__
+        epoll_event events[MAX_EVENTS];
+        int n = epoll_wait(epollFd, events, MAX_EVENTS, timeoutMs);
+        for (int i = 0; i < n; ++i) {
+            readyFds.push_back(events[i].data.fd);
+            readable.push_back((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0);
+            writable.push_back((events[i].events & EPOLLOUT) != 0);
+        }
+        return n;
+#else
+        int n = poll(fds.data(), fds.size(), timeoutMs);
+        for (size_t i = 0; n > 0 && i < fds.size(); ++i) {
+            if (fds[i].revents == 0) continue;
+            readyFds.push_back(fds[i].fd);
+            readable.push_back((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0);
+            writable.push_back((fds[i].revents & POLLOUT) != 0);
+        }
+        return n;
+#endif
+    }
+
+private:
+#ifdef __linux__
+    int epollFd = -1;
+#else
+    std::vector<pollfd> fds;
+#endif
+};
+
+// Split the connection's input into frames and queue each request into the tick
+void parseFrames(Connection& conn, Tick& tick) {
+    size_t pos = 0;
+    while (conn.input.size() - pos >= HEADER_SIZE) {
+        uint32_t length, id;
+        std::memcpy(&length, conn.input.data() + pos, 4);
+        std::memcpy(&id, conn.input.data() + pos + 4, 4);
+        uint8_t op = static_cast<uint8_t>(conn.input[pos + 8]);
+        if (length > MAX_PAYLOAD) {
+            std::cerr << "Error: Oversized frame, closing connection\n";
+            conn.closed = true;
+            return;
+        }
+        if (conn.input.size() - pos < HEADER_SIZE + length) break;
+        const char* payload = conn.input.data() + pos + HEADER_SIZE;
+
+        if (op == OP_IS_PRIME && length == 4) {
+            int32_t n;
+            std::memcpy(&n, payload, 4);
+            tick.primeRequests.push_back({conn.fd, id, 0, 0});
+            tick.primeValues.push_back(n);
+        } else if (op == OP_TO_UPPER) {
+            uint32_t offset = static_cast<uint32_t>(tick.upperBytes.size());
+            tick.upperBytes.append(payload, length);
+            tick.upperRequests.push_back({conn.fd, id, offset, length});
+        } else if (op == OP_CALC_AVERAGE && length > 0 && length % 8 == 0) {
+            uint32_t offset = static_cast<uint32_t>(tick.averageValues.size());
+            uint32_t count = length / 8;
+            tick.averageValues.resize(offset + count);
+            std::memcpy(tick.averageValues.data() + offset, payload, length);
+            tick.averageRequests.push_back({conn.fd, id, offset, count});
+        } else {
+            appendHeader(conn.output, 0, id, STATUS_BAD_REQUEST);
+        }
+        pos += HEADER_SIZE + length;
+    }
+    conn.input.erase(0, pos);
+}
+
+// Run one batched call per operation and append every answer to its connection
+void runTick(Tick& tick, std::unordered_map<int, Connection>& connections) {
+    auto outputFor = [&](int fd) -> std::string* {
+        auto it = connections.find(fd);
+        return it == connections.end() || it->second.closed ? nullptr : &it->second.output;
+    };
+
+    if (!tick.primeRequests.empty()) {
+        std::vector<uint8_t> results(tick.primeValues.size());
+        MathUtils::isPrimeBatch(tick.primeValues.data(),
+                                static_cast<int>(tick.primeValues.size()), results.data());
+        for (size_t i = 0; i < tick.primeRequests.size(); ++i) {
+            std::string* out = outputFor(tick.primeRequests[i].fd);
+            if (out == nullptr) continue;
+            appendHeader(*out, 1, tick.primeRequests[i].id, STATUS_OK);
+            out->push_back(static_cast<char>(results[i]));
+        }
+    }
+
+    if (!tick.upperRequests.empty()) {
+        StringUtils::toUpperCaseInPlace(&tick.upperBytes[0], tick.upperBytes.size());
+        for (const Pending& p : tick.upperRequests) {
+            std::string* out = outputFor(p.fd);
+            if (out == nullptr) continue;
+            appendHeader(*out, p.length, p.id, STATUS_OK);
+            out->append(tick.upperBytes, p.offset, p.length);
+        }
+    }
+
+    if (!tick.averageRequests.empty()) {
+        const size_t count = tick.averageRequests.size();
+        std::vector<uint32_t> offsets(count), counts(count);
+        for (size_t i = 0; i < count; ++i) {
+            offsets[i] = tick.averageRequests[i].offset;
+            counts[i] = tick.averageRequests[i].length;
+        }
+        std::vector<double> averages(count);
+        MathUtils::calculateAverageBatch(tick.averageValues.data(), offsets.data(), counts.data(),
+                                         static_cast<int>(count), averages.data());
+        for (size_t i = 0; i < count; ++i) {
+            std::string* out = outputFor(tick.averageRequests[i].fd);
+            if (out == nullptr) continue;
+            appendHeader(*out, 8, tick.averageRequests[i].id, STATUS_OK);
+            out->append(reinterpret_cast<const char*>(&averages[i]), 8);
+        }
+    }
+    tick.clear();
+}
+
+// Write as much pending output as the socket accepts
+void flushOutput(Connection& conn) {
+    size_t written = 0;
+    while (written < conn.output.size()) {
+        ssize_t n = send(conn.fd, conn.output.data() + written, conn.output.size() - written,
+                         MSG_NOSIGNAL_FLAG);
+        if (n > 0) {
+            written += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) conn.closed = true;
+            break;
+        }
+    }
+    conn.output.erase(0, written);
+}
+
+static volatile sig_atomic_t stopRequested = 0;
+void onSignal(int) { stopRequested = 1; }
+
+// Serve until SIGINT/SIGTERM
+int run(const std::string& path) {
+    sockaddr_un addr;
+    if (!makeAddress(path, addr)) return 1;
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        std::cerr << "Error: socket() failed: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0 || !setNonBlocking(listenFd)) {
+        std::cerr << "Error: cannot listen on " << path << ": " << std::strerror(errno) << "\n";
+        close(listenFd);
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    EventLoop loop;
+    if (!loop.ok()) {
+        std::cerr << "Error: cannot create event loop\n";
+        close(listenFd);
+        return 1;
+    }
+    loop.watch(listenFd, false);
+
+    std::unordered_map<int, Connection> connections;
+    Tick tick;
+    std::vector<int> readyFds;
+    std::vector<uint8_t> readable, writable;
+    std::vector<char> chunk(READ_CHUNK);
+    unsigned long long ticks = 0, requests = 0;
+
+    std::cout << "Serving on " << path << "\n";
+    while (!stopRequested) {
+        if (loop.wait(readyFds, readable, writable, 500) < 0 && errno != EINTR) {
+            std::cerr << "Error: wait failed: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        // 1. Gather: accept new clients, read and parse everything that is ready
+        for (size_t i = 0; i < readyFds.size(); ++i) {
+            int fd = readyFds[i];
+            if (fd == listenFd) {
+                int client;
+                while ((client = accept(listenFd, nullptr, nullptr)) >= 0) {
+                    setNonBlocking(client);
+                    connections[client].fd = client;
+                    loop.watch(client, false);
+                }
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) continue;
+            Connection& conn = it->second;
+            if (readable[i] && conn.wantRead && !conn.peerClosed) {
+                // A bounded read per tick; level-triggered readiness brings us back for
+                // the rest, after every other ready client has had its turn
+                size_t budget = READ_BUDGET;
+                while (budget > 0) {
+                    ssize_t n = recv(fd, chunk.data(), std::min(chunk.size(), budget), 0);
+                    if (n > 0) {
+                        conn.input.append(chunk.data(), static_cast<size_t>(n));
+                        budget -= static_cast<size_t>(n);
+                    } else if (n < 0 && errno == EINTR) {
+                        continue;
+                    } else if (n == 0) {
+                        // Half-close: stop reading but keep the socket for the answers
+                        conn.peerClosed = true;
+                        break;
+                    } else {
+                        if (errno != EAGAIN && errno != EWOULDBLOCK) conn.closed = true;
+                        break;
+                    }
+                }
+                size_t before = tick.primeRequests.size() + tick.upperRequests.size() +
+                                tick.averageRequests.size();
+                parseFrames(conn, tick);
+                requests += tick.primeRequests.size() + tick.upperRequests.size() +
+                            tick.averageRequests.size() - before;
+            }
+            if (writable[i]) conn.wantWrite = true;
+        }
+
+        // 2. Compute: one batched call per operation for the whole tick
+        if (!tick.empty()) {
+            runTick(tick, connections);
+            ++ticks;
+        }
+
+        // 3. Scatter: flush responses, drop closed connections
+        for (auto it = connections.begin(); it != connections.end();) {
+            Connection& conn = it->second;
+            if (!conn.closed && !conn.output.empty()) flushOutput(conn);
+            if (conn.closed || (conn.peerClosed && conn.output.empty())) {
+                loop.forget(conn.fd);
+                close(conn.fd);
+                it = connections.erase(it);
+                continue;
+            }
+            // Backpressure: a client that does not read its answers stops being read
+            bool needRead = !conn.peerClosed &&
+                            conn.output.size() < (conn.wantRead ? OUTPUT_HIGH_WATER
+                                                                : OUTPUT_LOW_WATER);
+            bool needWrite = !conn.output.empty() || conn.peerClosed;
+            if (needWrite != conn.wantWrite || needRead != conn.wantRead) {
+                loop.watch(conn.fd, needWrite, needRead);
+            }
+            conn.wantWrite = needWrite;
+            conn.wantRead = needRead;
+            ++it;
+        }
+    }
+
+    for (auto& entry : connections) close(entry.first);
+    close(listenFd);
+    unlink(path.c_str());
+    std::cout << "Served " << requests << " requests in " << ticks << " batches";
+    if (ticks > 0) std::cout << " (" << static_cast<double>(requests) / ticks << " per batch)";
+    std::cout << "\n";
+    return 0;
+}
+} // namespace BatchServer
+
+// === Load Generator ===
+namespace BatchClient {
+using namespace BatchProtocol;
+using Clock = std::chrono::steady_clock;
+
+struct ClientConnection {
+    int fd = -1;
+    std::string input;
+    std::string output;
+    int inFlight = 0;
+};
+
+// Connect to the server, retrying briefly while it starts up
+int connectTo(const std::string& path) {
+    sockaddr_un addr;
+    if (!makeAddress(path, addr)) return -1;
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0) {
+            setNonBlocking(fd);
+            return fd;
+        }
+        close(fd);
+        usleep(20000);
+    }
+    std::cerr << "Error: cannot connect to " << path << "\n";
+    return -1;
+}
+
+// Build a request with a mix of the three operations
+void appendRequest(std::string& out, uint32_t id) {
+    switch (id % 3) {
+    case 0: {
+        int32_t n = static_cast<int32_t>(1000003 + (id * 2654435761u) % 100000000u);
+        appendHeader(out, 4, id, OP_IS_PRIME);
+        out.append(reinterpret_cast<const char*>(&n), 4);
+        break;
+    }
+    case 1: {
+        static const char* words[] = {"hello", "radar", "Grok", "batching rocks", "xAI"};
+        const char* word = words[id % 5];
+        uint32_t length = static_cast<uint32_t>(std::strlen(word));
+        appendHeader(out, length, id, OP_TO_UPPER);
+        out.append(word, length);
+        break;
+    }
+    default: {
+        double values[4] = {1.5, 2.5, 3.5, static_cast<double>(id % 10)};
+        appendHeader(out, sizeof(values), id, OP_CALC_AVERAGE);
+        out.append(reinterpret_cast<const char*>(values), sizeof(values));
+        break;
+    }
+    }
+}
+
+// Check a response against a locally computed answer
+bool verifyResponse(uint32_t id, uint8_t status, const char* payload, uint32_t length) {
+    if (status != STATUS_OK) return false;
+    std::string expected;
+    appendRequest(expected, id);
+    const char* request = expected.data() + HEADER_SIZE;
+    uint32_t requestLength = static_cast<uint32_t>(expected.size() - HEADER_SIZE);
+    switch (id % 3) {
+    case 0: {
+        int32_t n;
+        std::memcpy(&n, request, 4);
+        return length == 1 && static_cast<bool>(payload[0]) == MathUtils::isPrime(n);
+    }
+    case 1:
+        return StringUtils::toUpperCase(std::string(request, requestLength)) ==
+               std::string(payload, length);
+    default: {
+        double values[4], avg;
+        std::memcpy(values, request, sizeof(values));
+        std::memcpy(&avg, payload, 8);
+        return length == 8 && avg == MathUtils::calculateAverage(values, 4);
+    }
+    }
+}
+
+// Send one request, then shutdown(SHUT_WR): the server must still answer before it closes
+bool halfCloseAnswered(const std::string& path) {
+    int fd = connectTo(path);
+    if (fd < 0) return false;
+    std::string request, input;
+    appendRequest(request, 0);
+    bool sent = send(fd, request.data(), request.size(), MSG_NOSIGNAL_FLAG) ==
+                static_cast<ssize_t>(request.size());
+    shutdown(fd, SHUT_WR);
+    std::vector<char> chunk(READ_CHUNK);
+    pollfd pfd = {fd, POLLIN, 0};
+    while (sent && poll(&pfd, 1, 5000) > 0) {
+        ssize_t n = recv(fd, chunk.data(), chunk.size(), 0);
+        if (n <= 0) break;
+        input.append(chunk.data(), static_cast<size_t>(n));
+    }
+    close(fd);
+    uint32_t length = 0, id = 0;
+    if (input.size() < HEADER_SIZE) return false;
+    std::memcpy(&length, input.data(), 4);
+    std::memcpy(&id, input.data() + 4, 4);
+    return id == 0 && input.size() == HEADER_SIZE + length &&
+           verifyResponse(id, static_cast<uint8_t>(input[8]), input.data() + HEADER_SIZE, length);
+}
+
+// Drive the server with `connections` sockets, each keeping `depth` requests in flight
+int run(const std::string& path, int connections, int depth, int totalRequests) {
+    if (connections <= 0 || depth <= 0 || totalRequests <= 0) {
+        std::cerr << "Error: connections, depth and requests must be positive\n";
+        return 1;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+    std::vector<ClientConnection> conns(connections);
+    for (ClientConnection& c : conns) {
+        c.fd = connectTo(path);
+        if (c.fd < 0) return 1;
+    }
+
+    std::vector<Clock::time_point> sentAt(totalRequests);
+    std::vector<double> latenciesUs;
+    latenciesUs.reserve(totalRequests);
+    int nextId = 0, completed = 0, mismatches = 0;
+    std::vector<pollfd> fds(connections);
+    std::vector<char> chunk(READ_CHUNK);
+    Clock::time_point start = Clock::now();
+
+    while (completed < totalRequests) {
+        // Top every connection up to the pipeline depth
+        for (ClientConnection& c : conns) {
+            while (c.inFlight < depth && nextId < totalRequests) {
+                sentAt[nextId] = Clock::now();
+                appendRequest(c.output, static_cast<uint32_t>(nextId++));
+                ++c.inFlight;
+            }
+        }
+        for (int i = 0; i < connections; ++i) {
+            fds[i].fd = conns[i].fd;
+            fds[i].events = POLLIN | (conns[i].output.empty() ? 0 : POLLOUT);
+            fds[i].revents = 0;
+        }
+        if (poll(fds.data(), fds.size(), 5000) <= 0) {
+            std::cerr << "Error: server stopped responding\n";
+            return 1;
+        }
+        for (int i = 0; i < connections; ++i) {
+            ClientConnection& c = conns[i];
+            if (fds[i].revents & POLLOUT) {
+                ssize_t n = send(c.fd, c.output.data(), c.output.size(), MSG_NOSIGNAL_FLAG);
+                if (n > 0) c.output.erase(0, static_cast<size_t>(n));
+            }
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                ssize_t n = recv(c.fd, chunk.data(), chunk.size(), 0);
+                if (n == 0) {
+                    std::cerr << "Error: server closed the connection\n";
+                    return 1;
+                }
+                if (n > 0) c.input.append(chunk.data(), static_cast<size_t>(n));
+            }
+            size_t pos = 0;
+            while (c.input.size() - pos >= HEADER_SIZE) {
+                uint32_t length, id;
+                std::memcpy(&length, c.input.data() + pos, 4);
+                std::memcpy(&id, c.input.data() + pos + 4, 4);
+                if (c.input.size() - pos < HEADER_SIZE + length) break;
+                uint8_t status = static_cast<uint8_t>(c.input[pos + 8]);
+                if (id >= static_cast<uint32_t>(totalRequests) ||
+                    !verifyResponse(id, status, c.input.data() + pos + HEADER_SIZE, length)) {
+                    ++mismatches;
+                }
+                if (id < static_cast<uint32_t>(totalRequests)) {
+                    std::chrono::duration<double, std::micro> us = Clock::now() - sentAt[id];
+                    latenciesUs.push_back(us.count());
+                }
+                --c.inFlight;
+                ++completed;
+                pos += HEADER_SIZE + length;
+            }
+            c.input.erase(0, pos);
+        }
+    }
+    std::chrono::duration<double> elapsed = Clock::now() - start;
+    for (ClientConnection& c : conns) close(c.fd);
+
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto percentile = [&](double q) {
+        return latenciesUs[static_cast<size_t>(q * (latenciesUs.size() - 1))];
+    };
+    std::cout << "Requests: " << completed << " over " << connections << " connections, depth "
+              << depth << "\n";
+    std::cout << "Throughput: " << completed / elapsed.count() << " req/s\n";
+    std::cout << "Latency p50: " << percentile(0.50) << " us, p99: " << percentile(0.99)
+              << " us\n";
+    std::cout << "Mismatched responses: " << mismatches << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
+} // namespace BatchClient
+
+// === Program Design: Main Function ===
+int main(int argc, char* argv[]) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    std::string path = argc > 2 ? argv[2] : DEFAULT_SOCKET_PATH;
+    int connections = argc > 3 ? std::atoi(argv[3]) : 4;
+    int depth = argc > 4 ? std::atoi(argv[4]) : 32;
+    int requests = argc > 5 ? std::atoi(argv[5]) : 200000;
+
+    if (mode == "server") return BatchServer::run(path);
+    if (mode == "bench") return BatchClient::run(path, connections, depth, requests);
+    if (!mode.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [server|bench] [socket_path] [connections]"
+                  << " [pipeline_depth] [requests]\n";
+        return 1;
+    }
+
+    // No mode given: demo both halves in one go
+    pid_t child = fork();
+    if (child < 0) {
+        std::cerr << "Error: fork() failed\n";
+        return 1;
+    }
+    if (child == 0) return BatchServer::run(path);
+    int result = BatchClient::run(path, connections, depth, requests);
+    bool halfClose = BatchClient::halfCloseAnswered(path);
+    std::cout << "Half-closed client answered: " << (halfClose ? "yes" : "NO") << "\n";
+    if (!halfClose) result = 1;
+    kill(child, SIGTERM);
+    waitpid(child, nullptr, 0);
+    return result;
+}
+
+// === Program Design Notes ===
+// - One thread does everything; the batching comes from the event loop, not from threads.
+// - A tick is one wait() call: gather every ready request, compute per-op batches, scatter.
+// - Responses are tagged with the request id, so the client never waits for ordering.
+// - Unknown opcodes and malformed payloads get a STATUS_BAD_REQUEST reply instead of a
+//   dropped connection; only oversized frames close the socket.
+// - A client that half-closes (EOF on read) still gets every answer it asked for; the
+//   socket is closed once its output has been flushed.
+// - Reads are capped at READ_BUDGET per client per tick, and a client whose unsent output
+//   passes OUTPUT_HIGH_WATER is not read again until it drains below OUTPUT_LOW_WATER.
+
+// === End of File ===
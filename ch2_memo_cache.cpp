@@ -0,0 +1,383 @@
+// File: ch2_memo_cache.cpp
+// Purpose: A memoization layer for the pure functions of ch2.cpp (MathUtils::factorial,
+//          MathUtils::isPrime, power). Repeated arguments are answered from a bounded,
+//          sharded, thread-safe cache instead of being recomputed.
+//          Build: g++ -std=c++17 -O2 -pthread ch2_memo_cache.cpp -o ch2_memo_cache
+
+// === Topic Overview ===
+// This program covers:
+// - ShardedClockCache: a fixed byte budget split over independent shards, each with its own
+//   lock, slot array and key -> slot index.
+// - CLOCK eviction: a hit only sets a reference bit, so lookups need a shared (reader) lock
+//   and many threads can hit the same shard at once; only inserts take the writer lock.
+// - Hit / miss / eviction counters per shard, summed on demand.
+// - memoize(): wraps any pure function pointer; the argument list becomes the cache key.
+// - A benchmark on Zipf-distributed arguments, cached vs uncached, 1 to N threads.
+
+// === Significance in Computer Science ===
+// Memoization trades memory for time, and works best when traffic is skewed: a few
+// arguments account for most calls. Under concurrency the cache itself becomes the
+// bottleneck, so it is split into shards (less contention) and uses CLOCK instead of a
+// strict LRU list (a hit does not have to move anything, so it does not need exclusive
+// access).
+
+// === Simulated Header File: math_utils.hpp ===
+#ifndef MATH_UTILS_HPP
+#define MATH_UTILS_HPP
+
+namespace MathUtils {
+// Forward declarations
+int factorial(int n);
+bool isPrime(int n);
+} // namespace MathUtils
+
+#endif // MATH_UTILS_HPP
+
+// === Simulated Header File: memo_cache.hpp ===
+#ifndef MEMO_CACHE_HPP
+#define MEMO_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace MemoCache {
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    double hitRate() const { return hits + misses == 0 ? 0.0 : double(hits) / (hits + misses); }
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class ShardedClockCache {
+public:
+    // capacityBytes is a budget for slots plus index entries; shardCount is rounded up to a
+    // power of two
+    ShardedClockCache(size_t capacityBytes, size_t shardCount = 16);
+
+    bool lookup(const Key& key, Value& value);
+    void insert(const Key& key, const Value& value);
+    CacheStats stats() const;
+    size_t capacity() const { return shardCount * shardCapacity; } // in entries
+
+    // Rough per-entry cost: the slot plus one hash-map node
+    static constexpr size_t entryBytes() {
+        return sizeof(Slot) + sizeof(Key) + sizeof(uint32_t) + 4 * sizeof(void*);
+    }
+
+private:
+    struct Slot {
+        Key key{};
+        Value value{};
+        std::atomic<uint8_t> referenced{0};
+        bool used = false;
+    };
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unique_ptr<Slot[]> slots;
+        std::unordered_map<Key, uint32_t, Hash> index;
+        uint32_t hand = 0;
+        std::atomic<uint64_t> hits{0}, misses{0}, evictions{0};
+    };
+
+    size_t shardCount;
+    size_t shardCapacity;
+    std::unique_ptr<Shard[]> shards;
+    Hash hasher;
+
+    Shard& shardFor(const Key& key);
+};
+
+// Hash for std::tuple keys (memoize() turns an argument list into a tuple)
+struct TupleHash {
+    template <typename... Ts>
+    size_t operator()(const std::tuple<Ts...>& t) const;
+};
+
+template <typename Result, typename... Args>
+class Memoized;
+
+template <typename Result, typename... Args>
+Memoized<Result, Args...> memoize(Result (*fn)(Args...), size_t capacityBytes,
+                                  size_t shardCount = 16);
+} // namespace MemoCache
+
+#endif // MEMO_CACHE_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+// === Function Definitions: MathUtils (from ch2.cpp) ===
+namespace MathUtils {
+// Calculate factorial recursively
+int factorial(int n) {
+    if (n < 0) {
+        std::cerr << "Error: Negative input for factorial\n";
+        return -1;
+    }
+    if (n == 0 || n == 1) return 1;
+    return n * factorial(n - 1);
+}
+
+// Check if a number is prime
+bool isPrime(int n) {
+    if (n <= 1) return false;
+    for (int i = 2; i <= std::sqrt(n); ++i) {
+        if (n % i == 0) return false;
+    }
+    return true;
+}
+} // namespace MathUtils
+
+// ch2.cpp's original O(exponent) loop (ch2.cpp now squares), kept as an expensive call
+double loopPower(double base, int exponent) {
+    if (exponent < 0) {
+        std::cerr << "Error: Negative exponent not supported\n";
+        return 0.0;
+    }
+    double result = 1.0;
+    for (int i = 0; i < exponent; ++i) {
+        result *= base;
+    }
+    return result;
+}
+
+// === Function Definitions: MemoCache ===
+namespace MemoCache {
+template <typename Key, typename Value, typename Hash>
+ShardedClockCache<Key, Value, Hash>::ShardedClockCache(size_t capacityBytes, size_t count)
+    : shardCount(1) {
+    while (shardCount < count) shardCount <<= 1;
+    shardCapacity = std::max<size_t>(1, capacityBytes / shardCount / entryBytes());
+    shards.reset(new Shard[shardCount]);
+    for (size_t s = 0; s < shardCount; ++s) {
+        shards[s].slots.reset(new Slot[shardCapacity]);
+        shards[s].index.reserve(shardCapacity);
+    }
+}
+
+// std::hash<int> is the identity, so mix before taking the high bits as the shard number
+template <typename Key, typename Value, typename Hash>
+typename ShardedClockCache<Key, Value, Hash>::Shard&
+ShardedClockCache<Key, Value, Hash>::shardFor(const Key& key) {
+    uint64_t h = static_cast<uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ULL;
+    return shards[(h >> 40) & (shardCount - 1)];
+}
+
+template <typename Key, typename Value, typename Hash>
+bool ShardedClockCache<Key, Value, Hash>::lookup(const Key& key, Value& value) {
+    Shard& shard = shardFor(key);
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.index.find(key);
+        if (it != shard.index.end()) {
+            Slot& slot = shard.slots[it->second];
+            value = slot.value;
+            if (slot.referenced.load(std::memory_order_relaxed) == 0) {
+                slot.referenced.store(1, std::memory_order_relaxed);
+            }
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+// CLOCK: sweep the hand, giving referenced slots a second chance, and reuse the first slot
+// that is empty or was not touched since the last sweep.
+template <typename Key, typename Value, typename Hash>
+void ShardedClockCache<Key, Value, Hash>::insert(const Key& key, const Value& value) {
+    Shard& shard = shardFor(key);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto it = shard.index.find(key);
+    if (it != shard.index.end()) {
+        shard.slots[it->second].value = value; // another thread computed it first
+        return;
+    }
+    while (true) {
+        Slot& slot = shard.slots[shard.hand];
+        if (!slot.used || slot.referenced.load(std::memory_order_relaxed) == 0) break;
+        slot.referenced.store(0, std::memory_order_relaxed);
+        shard.hand = static_cast<uint32_t>((shard.hand + 1) % shardCapacity);
+    }
+    Slot& victim = shard.slots[shard.hand];
+    if (victim.used) {
+        shard.index.erase(victim.key);
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    victim.key = key;
+    victim.value = value;
+    victim.used = true;
+    victim.referenced.store(0, std::memory_order_relaxed);
+    shard.index.emplace(key, shard.hand);
+    shard.hand = static_cast<uint32_t>((shard.hand + 1) % shardCapacity);
+}
+
+template <typename Key, typename Value, typename Hash>
+CacheStats ShardedClockCache<Key, Value, Hash>::stats() const {
+    CacheStats total;
+    for (size_t s = 0; s < shardCount; ++s) {
+        total.hits += shards[s].hits.load(std::memory_order_relaxed);
+        total.misses += shards[s].misses.load(std::memory_order_relaxed);
+        total.evictions += shards[s].evictions.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+template <typename... Ts>
+size_t TupleHash::operator()(const std::tuple<Ts...>& t) const {
+    size_t seed = 0;
+    std::apply([&seed](const Ts&... parts) {
+        ((seed ^= std::hash<Ts>()(parts) + 0x9E3779B9 + (seed << 6) + (seed >> 2)), ...);
+    }, t);
+    return seed;
+}
+
+// A function pointer plus its cache; call it exactly like the function it wraps
+template <typename Result, typename... Args>
+class Memoized {
+public:
+    typedef std::tuple<std::decay_t<Args>...> Key;
+
+    Memoized(Result (*fn)(Args...), size_t capacityBytes, size_t shardCount)
+        : function(fn), cache(new ShardedClockCache<Key, Result, TupleHash>(capacityBytes,
+                                                                             shardCount)) {}
+
+    Result operator()(Args... args) const {
+        Key key(args...);
+        Result result;
+        if (cache->lookup(key, result)) return result;
+        result = function(args...);
+        cache->insert(key, result);
+        return result;
+    }
+    CacheStats stats() const { return cache->stats(); }
+    size_t capacity() const { return cache->capacity(); }
+
+private:
+    Result (*function)(Args...);
+    std::shared_ptr<ShardedClockCache<Key, Result, TupleHash>> cache;
+};
+
+template <typename Result, typename... Args>
+Memoized<Result, Args...> memoize(Result (*fn)(Args...), size_t capacityBytes,
+                                  size_t shardCount) {
+    return Memoized<Result, Args...>(fn, capacityBytes, shardCount);
+}
+} // namespace MemoCache
+
+// === Utility Functions ===
+// Zipf(s) sampler over ranks 0..n-1 via an inverted CDF table
+class ZipfGenerator {
+public:
+    ZipfGenerator(size_t n, double s) : cdf(n) {
+        double sum = 0.0;
+        for (size_t k = 0; k < n; ++k) cdf[k] = sum += 1.0 / std::pow(double(k + 1), s);
+        for (double& c : cdf) c /= sum;
+    }
+    size_t operator()(std::mt19937& rng) {
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        return std::min(cdf.size() - 1,
+                        size_t(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin()));
+    }
+
+private:
+    std::vector<double> cdf;
+};
+
+// Run `threads` workers, each doing `perThread` calls; returns calls per second
+template <typename Work>
+double throughput(int threads, int perThread, Work work) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(work, t);
+    for (std::thread& thread : pool) thread.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return threads * double(perThread) / elapsed.count();
+}
+
+// === Program Design: Main Function ===
+int main(int argc, char* argv[]) {
+    const int perThread = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const size_t distinctKeys = 1 << 16;
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    bool ok = true;
+
+    // Arguments: Zipf ranks mapped to large odd numbers (expensive isPrime calls) and to
+    // (base, exponent) pairs with big exponents (expensive power calls)
+    std::vector<int> primeArgs(distinctKeys);
+    std::vector<int> exponents(distinctKeys);
+    std::mt19937 setupRng(32);
+    for (size_t k = 0; k < distinctKeys; ++k) {
+        primeArgs[k] = 1000000001 + 2 * static_cast<int>(setupRng() % 50000000);
+        exponents[k] = 2000 + static_cast<int>(setupRng() % 2000);
+    }
+    ZipfGenerator zipf(distinctKeys, 1.1);
+
+    // Small cache on purpose (a few thousand entries) so eviction is exercised
+    auto cachedIsPrime = MemoCache::memoize(MathUtils::isPrime, 256 * 1024);
+    auto cachedPower = MemoCache::memoize(loopPower, 256 * 1024);
+    auto cachedFactorial = MemoCache::memoize(MathUtils::factorial, 4096, 1);
+    std::cout << "factorial(10) = " << cachedFactorial(10) << ", again: " << cachedFactorial(10)
+              << " (hits: " << cachedFactorial.stats().hits << ")\n";
+    std::cout << "isPrime cache holds " << cachedIsPrime.capacity() << " entries\n\n";
+
+    for (int threads = 1;; threads = std::min(threads * 2, hardware)) {
+        std::vector<std::vector<size_t>> keys(threads, std::vector<size_t>(perThread));
+        for (int t = 0; t < threads; ++t) {
+            std::mt19937 rng(100 + t);
+            for (size_t& k : keys[t]) k = zipf(rng);
+        }
+        std::vector<long long> plainChecks(threads, 0), cachedChecks(threads, 0);
+
+        double plainPrime = throughput(threads, perThread, [&](int t) {
+            for (size_t k : keys[t]) plainChecks[t] += MathUtils::isPrime(primeArgs[k]);
+        });
+        double cachedPrime = throughput(threads, perThread, [&](int t) {
+            for (size_t k : keys[t]) cachedChecks[t] += cachedIsPrime(primeArgs[k]);
+        });
+        double plainPow = throughput(threads, perThread, [&](int t) {
+            for (size_t k : keys[t]) plainChecks[t] += loopPower(1.0001, exponents[k]) > 1.5;
+        });
+        double cachedPow = throughput(threads, perThread, [&](int t) {
+            for (size_t k : keys[t]) cachedChecks[t] += cachedPower(1.0001, exponents[k]) > 1.5;
+        });
+        ok = ok && plainChecks == cachedChecks;
+
+        std::cout << threads << " thread(s): isPrime " << plainPrime / 1e6 << " -> "
+                  << cachedPrime / 1e6 << " M calls/s, power " << plainPow / 1e6 << " -> "
+                  << cachedPow / 1e6 << " M calls/s\n";
+        if (threads == hardware) break;
+    }
+
+    MemoCache::CacheStats stats = cachedIsPrime.stats();
+    std::cout << "isPrime cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+              << stats.evictions << " evictions, hit rate " << stats.hitRate() << "\n";
+    std::cout << "cached results match uncached: " << (ok ? "yes" : "NO") << "\n";
+    return ok ? 0 : 1;
+}
+
+// === Program Design Notes ===
+// - Only pure functions may be memoized: the cache assumes equal arguments give equal
+//   results forever.
+// - Two threads that miss on the same key both compute it; the second insert just
+//   overwrites the value. That keeps the lock out of the (slow) computation.
+// - entryBytes() is an estimate of the hash-map node size; the budget is a bound on the
+//   cache's structures, not an exact malloc total.
+
+// === End of File ===
@@ -0,0 +1,383 @@
+// File: ch2_power.cpp
+// Purpose: The power family behind ch2.cpp's power(): exponentiation by squaring for any
+//          arithmetic type (compile-time when possible), modular power in Montgomery form,
+//          small-matrix power for linear recurrences, and a batch pow over arrays.
+//          Build: g++ -std=c++17 -O2 -march=native ch2_power.cpp -o ch2_power
+//          (powBatch needs more than baseline SSE2 to vectorize: SSE4.1, AVX2 or NEON)
+
+// === Topic Overview ===
+// This program covers:
+// - powi(): O(log n) exponentiation by squaring for integer and floating types, with
+//   negative exponents, usable in constant expressions (constexpr).
+// - powmod(): base^e mod m for 64-bit m. Odd moduli use Montgomery multiplication, which
+//   replaces the slow 128-by-64-bit division of every step with two multiplications.
+// - matrixPower() and linearRecurrence(): the k-th order recurrence
+//   a[n] = c[0]*a[n-1] + ... + c[k-1]*a[n-k] in O(k^3 log n), e.g. Fibonacci, Tribonacci.
+// - powBatch(): many bases (and exponents) at once, written lane by lane so the compiler
+//   turns the loop body into SIMD instructions.
+
+// === Significance in Computer Science ===
+// x^13 = x^8 * x^4 * x^1: reading the exponent in binary needs only log2(n) squarings and at
+// most as many extra multiplications. The same idea works for anything with an associative
+// multiply - integers modulo m (cryptography, hashing) and matrices (recurrences).
+
+// === Simulated Header File: power_utils.hpp ===
+#ifndef POWER_UTILS_HPP
+#define POWER_UTILS_HPP
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace PowerUtils {
+// base^exponent by squaring. For integer types a negative exponent truncates like 1 / x^n.
+template <typename T>
+constexpr T powi(T base, long long exponent) {
+    static_assert(std::is_arithmetic<T>::value, "powi needs an arithmetic type");
+    const bool negative = exponent < 0;
+    // Magnitude as unsigned so LLONG_MIN is handled too
+    unsigned long long n = negative ? 0ULL - static_cast<unsigned long long>(exponent)
+                                    : static_cast<unsigned long long>(exponent);
+    if (negative && std::is_integral<T>::value) {
+        if (base == T(1)) return T(1);
+        if (base == T(-1)) return (n & 1) ? T(-1) : T(1);
+        return T(0);
+    }
+    T result = T(1);
+    while (n > 0) {
+        if (n & 1) result *= base;
+        n >>= 1;
+        if (n > 0) base *= base; // skip the last squaring: it may overflow when result fits
+    }
+    return negative ? T(1) / result : result;
+}
+
+uint64_t powmod(uint64_t base, uint64_t exponent, uint64_t modulus);
+
+template <typename T, int K>
+using Matrix = std::array<std::array<T, K>, K>;
+
+// K-th order linear recurrence modulo `modulus` (0 means wrap at 2^64):
+//   a[n] = coeffs[0] * a[n-1] + ... + coeffs[K-1] * a[n-K],  initial = {a[0], ..., a[K-1]}
+template <int K>
+uint64_t linearRecurrence(const std::array<uint64_t, K>& coeffs,
+                          const std::array<uint64_t, K>& initial, uint64_t n,
+                          uint64_t modulus = 0);
+
+void powBatch(const double* bases, const int* exponents, double* out, int count);
+void powBatch(const double* bases, int exponent, double* out, int count);
+} // namespace PowerUtils
+
+#endif // POWER_UTILS_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <climits>
+#include <random>
+#include <vector>
+
+#ifndef __SIZEOF_INT128__
+#error "powmod needs a compiler with unsigned __int128 (GCC or Clang on a 64-bit target)"
+#endif
+
+// === Preprocessor Directives ===
+#define BATCH_LANES 8
+
+typedef unsigned __int128 uint128;
+
+// === Function Definitions: modular power ===
+namespace PowerUtils {
+// Plain 64-bit modular multiply through a 128-bit product and a division
+inline uint64_t mulmod(uint64_t a, uint64_t b, uint64_t modulus) {
+    return static_cast<uint64_t>(static_cast<uint128>(a) * b % modulus);
+}
+
+// (a + b) mod m for a, b < m, without overflowing when m > 2^63
+inline uint64_t addmod(uint64_t a, uint64_t b, uint64_t modulus) {
+    return a >= modulus - b ? a - (modulus - b) : a + b;
+}
+
+// Montgomery arithmetic modulo an odd n: values are kept as aR mod n with R = 2^64, and
+// reduce(t) = t / R mod n needs only multiplications because R is a power of two.
+class Montgomery {
+public:
+    explicit Montgomery(uint64_t n) : modulus(n), inverse(n) {
+        // Newton's iteration doubles the correct low bits each step: 3 -> 6 -> ... -> 96
+        for (int i = 0; i < 5; ++i) inverse *= 2 - modulus * inverse;
+        const uint128 allOnes = ~static_cast<uint128>(0); // R^2 - 1
+        rSquared = static_cast<uint64_t>((allOnes % modulus + 1) % modulus);
+    }
+    uint64_t reduce(uint128 t) const {
+        // m * n has the same low 64 bits as t, so (t - m*n) / R is just the high halves
+        const uint64_t m = static_cast<uint64_t>(t) * inverse;
+        const uint64_t mnHigh = static_cast<uint64_t>((static_cast<uint128>(m) * modulus) >> 64);
+        const uint64_t tHigh = static_cast<uint64_t>(t >> 64);
+        return tHigh >= mnHigh ? tHigh - mnHigh : tHigh - mnHigh + modulus;
+    }
+    uint64_t toMontgomery(uint64_t a) const {
+        return reduce(static_cast<uint128>(a % modulus) * rSquared);
+    }
+    uint64_t fromMontgomery(uint64_t a) const { return reduce(a); }
+    uint64_t multiply(uint64_t a, uint64_t b) const {
+        return reduce(static_cast<uint128>(a) * b);
+    }
+
+private:
+    uint64_t modulus;
+    uint64_t inverse; // modulus * inverse == 1 (mod 2^64)
+    uint64_t rSquared;
+};
+
+uint64_t powmod(uint64_t base, uint64_t exponent, uint64_t modulus) {
+    if (modulus == 0) {
+        std::cerr << "Error: Modulus must be positive\n";
+        return 0;
+    }
+    if (modulus == 1) return 0;
+    if (modulus % 2 == 0) {
+        // Montgomery needs an odd modulus; even ones take the division path
+        uint64_t result = 1;
+        base %= modulus;
+        while (exponent > 0) {
+            if (exponent & 1) result = mulmod(result, base, modulus);
+            base = mulmod(base, base, modulus);
+            exponent >>= 1;
+        }
+        return result;
+    }
+    const Montgomery mont(modulus);
+    uint64_t result = mont.toMontgomery(1);
+    uint64_t b = mont.toMontgomery(base);
+    while (exponent > 0) {
+        if (exponent & 1) result = mont.multiply(result, b);
+        b = mont.multiply(b, b);
+        exponent >>= 1;
+    }
+    return mont.fromMontgomery(result);
+}
+} // namespace PowerUtils
+
+// === Function Definitions: matrix power ===
+namespace PowerUtils {
+template <int K>
+Matrix<uint64_t, K> multiply(const Matrix<uint64_t, K>& a, const Matrix<uint64_t, K>& b,
+                             uint64_t modulus) {
+    Matrix<uint64_t, K> c{};
+    for (int i = 0; i < K; ++i) {
+        for (int k = 0; k < K; ++k) {
+            for (int j = 0; j < K; ++j) {
+                c[i][j] = modulus == 0 ? c[i][j] + a[i][k] * b[k][j]
+                                       : addmod(c[i][j], mulmod(a[i][k], b[k][j], modulus), modulus);
+            }
+        }
+    }
+    return c;
+}
+
+template <int K>
+Matrix<uint64_t, K> matrixPower(Matrix<uint64_t, K> base, uint64_t exponent, uint64_t modulus) {
+    Matrix<uint64_t, K> result{};
+    for (int i = 0; i < K; ++i) result[i][i] = modulus == 1 ? 0 : 1;
+    while (exponent > 0) {
+        if (exponent & 1) result = multiply<K>(result, base, modulus);
+        base = multiply<K>(base, base, modulus);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+// The companion matrix shifts the window (a[n-1], ..., a[n-K]) forward by one step, so
+// its (n - K + 1)-th power applied to the initial window yields a[n].
+template <int K>
+uint64_t linearRecurrence(const std::array<uint64_t, K>& coeffs,
+                          const std::array<uint64_t, K>& initial, uint64_t n,
+                          uint64_t modulus) {
+    if (n < static_cast<uint64_t>(K)) return modulus == 0 ? initial[n] : initial[n] % modulus;
+    Matrix<uint64_t, K> step{};
+    for (int j = 0; j < K; ++j) step[0][j] = modulus == 0 ? coeffs[j] : coeffs[j] % modulus;
+    for (int i = 1; i < K; ++i) step[i][i - 1] = 1;
+    Matrix<uint64_t, K> m = matrixPower<K>(step, n - K + 1, modulus);
+    uint64_t result = 0;
+    for (int j = 0; j < K; ++j) {
+        const uint64_t term = modulus == 0 ? initial[K - 1 - j] : initial[K - 1 - j] % modulus;
+        result = modulus == 0 ? result + m[0][j] * term
+                              : addmod(result, mulmod(m[0][j], term, modulus), modulus);
+    }
+    return result;
+}
+} // namespace PowerUtils
+
+// === Function Definitions: batch pow ===
+namespace PowerUtils {
+// BATCH_LANES independent squarings side by side. Each lane multiplies by 1.0 once its
+// exponent runs out, so every lane does the same work and the loop has no branches.
+void powBatch(const double* bases, const int* exponents, double* out, int count) {
+    int i = 0;
+    for (; i + BATCH_LANES <= count; i += BATCH_LANES) {
+        double base[BATCH_LANES], result[BATCH_LANES];
+        uint64_t n[BATCH_LANES];
+        uint64_t remaining = 0;
+        for (int l = 0; l < BATCH_LANES; ++l) {
+            const long long e = exponents[i + l];
+            base[l] = bases[i + l];
+            result[l] = 1.0;
+            n[l] = static_cast<uint64_t>(e < 0 ? -e : e);
+            remaining |= n[l];
+        }
+        while (remaining != 0) {
+            remaining = 0;
+            for (int l = 0; l < BATCH_LANES; ++l) {
+                result[l] *= (n[l] & 1) ? base[l] : 1.0;
+                base[l] *= base[l];
+                n[l] >>= 1;
+                remaining |= n[l];
+            }
+        }
+        for (int l = 0; l < BATCH_LANES; ++l) {
+            out[i + l] = exponents[i + l] < 0 ? 1.0 / result[l] : result[l];
+        }
+    }
+    for (; i < count; ++i) out[i] = powi(bases[i], exponents[i]);
+}
+
+// Shared exponent: the bit pattern is the same for every element, so the loop over the
+// array is the inner loop and vectorizes directly.
+void powBatch(const double* bases, int exponent, double* out, int count) {
+    const bool negative = exponent < 0;
+    unsigned long long n = negative ? 0ULL - static_cast<unsigned long long>(exponent)
+                                    : static_cast<unsigned long long>(exponent);
+    std::vector<double> square(bases, bases + count);
+    for (int i = 0; i < count; ++i) out[i] = 1.0;
+    while (n > 0) {
+        if (n & 1) {
+            for (int i = 0; i < count; ++i) out[i] *= square[i];
+        }
+        n >>= 1;
+        if (n > 0) {
+            for (int i = 0; i < count; ++i) square[i] *= square[i];
+        }
+    }
+    if (negative) {
+        for (int i = 0; i < count; ++i) out[i] = 1.0 / out[i];
+    }
+}
+} // namespace PowerUtils
+
+// === Utility Functions ===
+// ch2.cpp's original O(exponent) loop, kept as the baseline
+double loopPower(double base, int exponent) {
+    double result = 1.0;
+    for (int i = 0; i < exponent; ++i) result *= base;
+    return result;
+}
+
+// Relative error check that tolerates the different rounding order
+bool closeTo(double a, double b) {
+    if (std::isinf(a) || std::isinf(b)) return a == b;
+    return std::fabs(a - b) <= 1e-11 * std::max(1.0, std::fabs(b));
+}
+
+template <typename Fn>
+double millisecondsFor(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// === Compile-time checks ===
+static_assert(PowerUtils::powi(2, 10) == 1024, "integer power");
+static_assert(PowerUtils::powi(2.0, -2) == 0.25, "negative exponent");
+static_assert(PowerUtils::powi(-1LL, -3) == -1, "integer negative exponent");
+static_assert(PowerUtils::powi(3ULL, 40) == 12157665459056928801ULL, "64-bit power");
+static_assert(PowerUtils::powi(2, 30) == 1 << 30, "int power at the limit");
+static_assert(PowerUtils::powi(3LL, 39) == 4052555153018976267LL, "signed 64-bit power");
+static_assert(PowerUtils::powi(-2LL, 63) == LLONG_MIN, "signed 64-bit minimum");
+
+// === Program Design: Main Function ===
+int main() {
+    bool ok = true;
+
+    constexpr double compound = PowerUtils::powi(1.05, 30); // folded by the compiler
+    std::cout << "1.05^30 = " << compound << " (computed at compile time)\n";
+    std::cout << "2^-3 = " << PowerUtils::powi(2.0, -3) << "\n";
+    std::cout << "3^200 mod 1e9+7 = " << PowerUtils::powmod(3, 200, 1000000007ULL) << "\n";
+
+    // Fermat: a^(p-1) == 1 mod p for the prime 2^61 - 1
+    const uint64_t mersenne61 = (1ULL << 61) - 1;
+    ok = ok && PowerUtils::powmod(123456789, mersenne61 - 1, mersenne61) == 1;
+
+    // Montgomery vs the division path on random odd and even moduli
+    std::mt19937_64 rng(33);
+    for (int trial = 0; trial < 20000 && ok; ++trial) {
+        uint64_t modulus = rng() >> (trial % 64);
+        if (modulus == 0) modulus = 3;
+        uint64_t base = rng(), exponent = rng() % 1000;
+        uint64_t expected = 1 % modulus, b = base % modulus;
+        for (uint64_t e = exponent; e > 0; e >>= 1) {
+            if (e & 1) expected = PowerUtils::mulmod(expected, b, modulus);
+            b = PowerUtils::mulmod(b, b, modulus);
+        }
+        ok = PowerUtils::powmod(base, exponent, modulus) == expected;
+    }
+    std::cout << "powmod matches reference: " << (ok ? "yes" : "NO") << "\n";
+
+    // Recurrences: Fibonacci (exact up to F(93)) and Tribonacci mod 1e9+7
+    const std::array<uint64_t, 2> fibCoeffs = {1, 1}, fibStart = {0, 1};
+    const std::array<uint64_t, 3> tribCoeffs = {1, 1, 1}, tribStart = {0, 0, 1};
+    uint64_t fib90 = PowerUtils::linearRecurrence<2>(fibCoeffs, fibStart, 90);
+    uint64_t trib = PowerUtils::linearRecurrence<3>(tribCoeffs, tribStart, 1000000000000ULL,
+                                                    1000000007ULL);
+    std::cout << "F(90) = " << fib90 << ", T(10^12) mod 1e9+7 = " << trib << "\n";
+    ok = ok && fib90 == 2880067194370816120ULL;
+    uint64_t a = 0, b1 = 0, c = 1;
+    for (int n = 3; n <= 37; ++n) {
+        uint64_t next = a + b1 + c;
+        a = b1;
+        b1 = c;
+        c = next;
+    }
+    ok = ok && PowerUtils::linearRecurrence<3>(tribCoeffs, tribStart, 37) == c;
+
+    // Scalar speed: loop vs squaring for large exponents
+    const int count = 1 << 16;
+    std::vector<double> bases(count), loopOut(count), fastOut(count), batchOut(count);
+    std::vector<int> exponents(count);
+    std::uniform_real_distribution<double> baseDist(0.999, 1.001);
+    for (int i = 0; i < count; ++i) {
+        bases[i] = baseDist(rng);
+        exponents[i] = static_cast<int>(rng() % 20000) - 10000;
+    }
+    std::cout << "\n=== " << count << " powers, |exponent| < 10000 ===\n";
+    std::cout << "loop (ch2.cpp before): " << millisecondsFor([&] {
+        for (int i = 0; i < count; ++i) {
+            double r = loopPower(bases[i], std::abs(exponents[i]));
+            loopOut[i] = exponents[i] < 0 ? 1.0 / r : r;
+        }
+    }) << " ms\n";
+    std::cout << "powi:                  " << millisecondsFor([&] {
+        for (int i = 0; i < count; ++i) fastOut[i] = PowerUtils::powi(bases[i], exponents[i]);
+    }) << " ms\n";
+    std::cout << "powBatch:              " << millisecondsFor([&] {
+        PowerUtils::powBatch(bases.data(), exponents.data(), batchOut.data(), count);
+    }) << " ms\n";
+    for (int i = 0; i < count; ++i) {
+        ok = ok && closeTo(fastOut[i], std::pow(bases[i], exponents[i])) &&
+             closeTo(batchOut[i], fastOut[i]) && closeTo(loopOut[i], fastOut[i]);
+    }
+    PowerUtils::powBatch(bases.data(), -777, batchOut.data(), count);
+    for (int i = 0; i < count; ++i) ok = ok && closeTo(batchOut[i], std::pow(bases[i], -777));
+
+    std::cout << "all results agree: " << (ok ? "yes" : "NO") << "\n";
+    return ok ? 0 : 1;
+}
+
+// === Program Design Notes ===
+// - Squaring changes the rounding order compared with the old loop, so floating results
+//   can differ in the last bits (they are usually closer to std::pow, not further).
+// - Montgomery form pays off over many multiplications with one modulus; for a single
+//   multiply the setup (inverse and R^2 mod n) costs more than it saves.
+
+// === End of File ===
@@ -0,0 +1,419 @@
+// File: ch2_selection.cpp
+// Purpose: Generalizes ch2.cpp's findMax() from "the largest element" to "the k-th
+//          element", "the K largest" and "these percentiles", without sorting a copy of
+//          the whole array.
+//          Build: g++ -std=c++17 -O2 -pthread ch2_selection.cpp -o ch2_selection
+//          (add -march=native for the AVX filter)
+
+// === Topic Overview ===
+// This program covers:
+// - nthElement(): Floyd-Rivest selection in place on a ch2-style double arr[]. It picks
+//   two pivots from a small recursive sample so that the k-th element almost always lands
+//   in a tiny middle band; if it ever needs too many rounds it hands over to
+//   std::nth_element (introselect), which bounds the worst case.
+// - topK(): keeps a threshold (the smallest value still in the running top K) and uses
+//   SIMD compares to skip every block of 8 values below it. Survivors go to a flat buffer
+//   that is trimmed back to K with nthElement() when it fills up, so there is no heap.
+// - quantiles(): several order statistics in one call; each partition step serves every
+//   requested rank on its side, so later ranks reuse the earlier work.
+// - topKParallel(): per-thread topK() on slices, then one small merge.
+
+// === Significance in Computer Science ===
+// Sorting answers every order question at O(n log n). Selection answers one in O(n), and
+// top-K with a threshold does even better in practice: after the first few thousand
+// elements almost nothing beats the threshold, so the scan becomes a compare per value
+// that runs at memory bandwidth.
+
+// === Simulated Header File: selection_utils.hpp ===
+#ifndef SELECTION_UTILS_HPP
+#define SELECTION_UTILS_HPP
+
+#include <vector>
+
+namespace SelectionUtils {
+// Reorders arr so arr[k] is the k-th smallest (0-based), smaller values before it and
+// larger after it
+void nthElement(double arr[], int size, int k);
+double kthSmallest(double arr[], int size, int k);
+double median(double arr[], int size);
+// The k largest values, largest first; arr is not modified
+std::vector<double> topK(const double arr[], int size, int k);
+std::vector<double> topKParallel(const double arr[], int size, int k, int threads);
+// out[i] = value at rank floor(qs[i] * (size - 1)); arr is reordered
+void quantiles(double arr[], int size, const std::vector<double>& qs, std::vector<double>& out);
+} // namespace SelectionUtils
+
+#endif // SELECTION_UTILS_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <random>
+#include <thread>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// === Preprocessor Directives ===
+#define FILTER_BLOCK 8
+#define FLOYD_RIVEST_CUTOFF 600 // below this, plain partitioning is faster than sampling
+
+// Function to find the maximum element in an array (ch2.cpp)
+double findMax(double arr[], int size) {
+    if (size <= 0) {
+        std::cerr << "Error: Invalid array size\n";
+        return 0.0;
+    }
+    double maxVal = arr[0];
+    for (int i = 1; i < size; ++i) {
+        maxVal = std::max(maxVal, arr[i]);
+    }
+    return maxVal;
+}
+
+// === Function Definitions: SelectionUtils ===
+namespace SelectionUtils {
+// Floyd & Rivest (1975), "Algorithm 489". [left, right] is inclusive.
+static void floydRivest(double arr[], long left, long right, long k, int& budget) {
+    while (right > left) {
+        if (--budget < 0) {
+            std::nth_element(arr + left, arr + k, arr + right + 1);
+            return;
+        }
+        if (right - left > FLOYD_RIVEST_CUTOFF) {
+            // Recursively select from a sample of size s so the pivot lands just around k
+            const double n = double(right - left + 1);
+            const double i = double(k - left + 1);
+            const double z = std::log(n);
+            const double s = 0.5 * std::exp(2.0 * z / 3.0);
+            const double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1.0 : 1.0);
+            const long newLeft = std::max(left, long(double(k) - i * s / n + sd));
+            const long newRight = std::min(right, long(double(k) + (n - i) * s / n + sd));
+            floydRivest(arr, newLeft, newRight, k, budget);
+        }
+        const double t = arr[k];
+        long i = left, j = right;
+        std::swap(arr[left], arr[k]);
+        if (arr[right] > t) std::swap(arr[right], arr[left]);
+        while (i < j) {
+            std::swap(arr[i], arr[j]);
+            ++i;
+            --j;
+            while (arr[i] < t) ++i;
+            while (arr[j] > t) --j;
+        }
+        if (arr[left] == t) {
+            std::swap(arr[left], arr[j]);
+        } else {
+            ++j;
+            std::swap(arr[j], arr[right]);
+        }
+        if (j <= k) left = j + 1;
+        if (k <= j) right = j - 1;
+    }
+}
+
+void nthElement(double arr[], int size, int k) {
+    if (size <= 0 || k < 0 || k >= size) {
+        std::cerr << "Error: Invalid array size or rank\n";
+        return;
+    }
+    // A few dozen rounds is plenty for random data; more means adversarial input
+    int budget = 4 * (1 + static_cast<int>(std::log2(double(size))));
+    floydRivest(arr, 0, size - 1, k, budget);
+}
+
+double kthSmallest(double arr[], int size, int k) {
+    if (size <= 0 || k < 0 || k >= size) {
+        std::cerr << "Error: Invalid array size or rank\n";
+        return 0.0;
+    }
+    nthElement(arr, size, k);
+    return arr[k];
+}
+
+double median(double arr[], int size) {
+    return kthSmallest(arr, size, (size - 1) / 2);
+}
+
+// Bit i set when p[i] > threshold, for i < FILTER_BLOCK
+static inline unsigned aboveMask(const double* p, double threshold) {
+#if defined(__AVX__)
+    const __m256d t = _mm256_set1_pd(threshold);
+    const unsigned lo = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), t, _CMP_GT_OQ));
+    const unsigned hi = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p + 4), t, _CMP_GT_OQ));
+    return lo | hi << 4;
+#elif defined(__SSE2__)
+    const __m128d t = _mm_set1_pd(threshold);
+    unsigned mask = 0;
+    for (int i = 0; i < FILTER_BLOCK; i += 2) {
+        mask |= static_cast<unsigned>(_mm_movemask_pd(_mm_cmpgt_pd(_mm_loadu_pd(p + i), t))) << i;
+    }
+    return mask;
+#elif defined(__ARM_NEON)
+    const float64x2_t t = vdupq_n_f64(threshold);
+    unsigned mask = 0;
+    for (int i = 0; i < FILTER_BLOCK; i += 2) {
+        const uint64x2_t gt = vcgtq_f64(vld1q_f64(p + i), t);
+        mask |= static_cast<unsigned>(vgetq_lane_u64(gt, 0) & 1) << i;
+        mask |= static_cast<unsigned>(vgetq_lane_u64(gt, 1) & 1) << (i + 1);
+    }
+    return mask;
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < FILTER_BLOCK; ++i) mask |= static_cast<unsigned>(p[i] > threshold) << i;
+    return mask;
+#endif
+}
+
+// Candidates above the threshold collect in `buffer`; when it fills, keep only the best k
+// and raise the threshold to the smallest of them. Until that first trim every value is
+// taken, so -inf values still count as candidates.
+class TopKCollector {
+public:
+    explicit TopKCollector(int k)
+        : k(k), capacity(std::max(2 * k, 4096)),
+          threshold(-std::numeric_limits<double>::infinity()), filled(false) {
+        buffer.reserve(capacity + FILTER_BLOCK);
+    }
+    void scan(const double* arr, long size) {
+        long i = 0;
+        for (; i < size && !filled; ++i) {
+            buffer.push_back(arr[i]);
+            if (static_cast<int>(buffer.size()) >= capacity) trim();
+        }
+        for (; i + FILTER_BLOCK <= size; i += FILTER_BLOCK) {
+            unsigned mask = aboveMask(arr + i, threshold);
+            while (mask != 0) {
+                buffer.push_back(arr[i + __builtin_ctz(mask)]);
+                mask &= mask - 1;
+            }
+            if (static_cast<int>(buffer.size()) >= capacity) trim();
+        }
+        for (; i < size; ++i) {
+            if (arr[i] > threshold) buffer.push_back(arr[i]);
+        }
+    }
+    void add(const std::vector<double>& values) {
+        for (double v : values) {
+            if (!filled || v > threshold) buffer.push_back(v);
+            if (static_cast<int>(buffer.size()) >= capacity) trim();
+        }
+    }
+    std::vector<double> result() {
+        trim();
+        std::sort(buffer.begin(), buffer.end(), std::greater<double>());
+        return buffer;
+    }
+
+private:
+    // Values equal to the threshold can be dropped: at least k values >= it are kept
+    void trim() {
+        const int n = static_cast<int>(buffer.size());
+        if (n <= k) return;
+        nthElement(buffer.data(), n, n - k);
+        buffer.erase(buffer.begin(), buffer.begin() + (n - k));
+        threshold = buffer.front();
+        for (double v : buffer) threshold = std::min(threshold, v);
+        filled = true;
+    }
+
+    int k;
+    int capacity;
+    double threshold;
+    bool filled; // k values kept, so `threshold` is a real lower bound
+    std::vector<double> buffer;
+};
+
+std::vector<double> topK(const double arr[], int size, int k) {
+    if (size < 0 || k < 0) {
+        std::cerr << "Error: Invalid array size or count\n";
+        return {};
+    }
+    k = std::min(k, size);
+    if (k == 0) return {};
+    TopKCollector collector(k);
+    collector.scan(arr, size);
+    return collector.result();
+}
+
+std::vector<double> topKParallel(const double arr[], int size, int k, int threads) {
+    if (size < 0 || k < 0) {
+        std::cerr << "Error: Invalid array size or count\n";
+        return {};
+    }
+    k = std::min(k, size);
+    if (k == 0) return {};
+    threads = std::max(1, std::min(threads, size / 65536 + 1));
+    if (threads == 1) return topK(arr, size, k);
+    std::vector<std::vector<double>> partial(threads);
+    std::vector<std::thread> pool;
+    const long chunk = (static_cast<long>(size) + threads - 1) / threads;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            const long begin = std::min<long>(size, chunk * t);
+            const long end = std::min<long>(size, begin + chunk);
+            partial[t] = topK(arr + begin, static_cast<int>(end - begin), k);
+        });
+    }
+    for (std::thread& thread : pool) thread.join();
+    TopKCollector merge(k);
+    for (const std::vector<double>& p : partial) merge.add(p);
+    return merge.result();
+}
+
+// Select the middle requested rank, then recurse into each side with only the ranks
+// that fall there
+static void multiSelect(double arr[], long left, long right, const long* ranks, int count) {
+    if (count == 0 || left >= right) return;
+    const int mid = count / 2;
+    const long k = ranks[mid];
+    int budget = 4 * (1 + static_cast<int>(std::log2(double(right - left + 1))));
+    floydRivest(arr, left, right, k, budget);
+    multiSelect(arr, left, k - 1, ranks, mid);
+    multiSelect(arr, k + 1, right, ranks + mid + 1, count - mid - 1);
+}
+
+void quantiles(double arr[], int size, const std::vector<double>& qs, std::vector<double>& out) {
+    out.assign(qs.size(), 0.0);
+    if (size <= 0) {
+        std::cerr << "Error: Invalid array size\n";
+        return;
+    }
+    std::vector<long> ranks;
+    for (double q : qs) {
+        q = std::min(1.0, std::max(0.0, q));
+        ranks.push_back(static_cast<long>(q * (size - 1)));
+    }
+    std::vector<long> unique = ranks;
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    multiSelect(arr, 0, size - 1, unique.data(), static_cast<int>(unique.size()));
+    for (size_t i = 0; i < qs.size(); ++i) out[i] = arr[ranks[i]];
+}
+} // namespace SelectionUtils
+
+// === Utility Functions ===
+template <typename Fn>
+double millisecondsFor(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Check selection results against a fully sorted copy
+bool verify(const std::vector<double>& data, int k) {
+    std::vector<double> sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    const int n = static_cast<int>(data.size());
+    std::vector<double> work = data;
+    bool ok = SelectionUtils::kthSmallest(work.data(), n, n / 3) == sorted[n / 3];
+    std::vector<double> expectedTop(sorted.rbegin(), sorted.rbegin() + std::min(k, n));
+    ok = ok && SelectionUtils::topK(data.data(), n, k) == expectedTop;
+    ok = ok && SelectionUtils::topKParallel(data.data(), n, k, 3) == expectedTop;
+    std::vector<double> qs = {0.0, 0.5, 0.9, 0.99, 1.0, 0.25}, out;
+    work = data;
+    SelectionUtils::quantiles(work.data(), n, qs, out);
+    for (size_t i = 0; i < qs.size(); ++i) {
+        ok = ok && out[i] == sorted[static_cast<long>(qs[i] * (n - 1))];
+    }
+    return ok;
+}
+
+// === Program Design: Main Function ===
+int main(int argc, char* argv[]) {
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    const long maxSize = argc > 1 ? std::atol(argv[1]) : 10000000;
+    const int k = argc > 2 ? std::atoi(argv[2]) : 100;
+    std::mt19937_64 rng(34);
+    bool ok = true;
+
+    double numbers[] = {1.5, 2.5, 3.5, 4.5, 5.5};
+    std::vector<double> top2 = SelectionUtils::topK(numbers, 5, 2);
+    std::cout << "findMax: " << findMax(numbers, 5) << ", top 2: " << top2[0] << " " << top2[1]
+              << ", median: " << SelectionUtils::median(numbers, 5) << "\n";
+
+    // Random, sorted, reversed, duplicate-heavy and mostly -inf inputs
+    std::uniform_real_distribution<double> valueDist(-1e6, 1e6);
+    const double negInf = -std::numeric_limits<double>::infinity();
+    for (int shape = 0; shape < 5 && ok; ++shape) {
+        for (int n : {1, 7, 100, 5000, 200000}) {
+            std::vector<double> data(n);
+            for (double& v : data) {
+                v = shape == 3 ? double(rng() % 10) : valueDist(rng);
+                if (shape == 4 && rng() % 1000 != 0) v = negInf;
+            }
+            if (shape == 1) std::sort(data.begin(), data.end());
+            if (shape == 2) std::sort(data.rbegin(), data.rend());
+            ok = ok && verify(data, std::min(n, 50));
+        }
+    }
+    std::cout << "selection matches sorting: " << (ok ? "yes" : "NO") << "\n";
+
+    for (long n = 1000000; n <= maxSize; n *= 10) {
+        std::vector<double> data(n);
+        for (double& v : data) v = valueDist(rng);
+        std::vector<double> work;
+        std::vector<double> fromSort, fromTopK, fromParallel;
+        const int size = static_cast<int>(n);
+        std::cout << "\n=== n = " << n << ", k = " << k << " ===\n";
+        double maxValue = 0.0;
+        std::cout << "findMax:             " << millisecondsFor([&] {
+            maxValue = findMax(data.data(), size);
+        }) << " ms\n";
+        ok = ok && maxValue == SelectionUtils::topK(data.data(), size, 1)[0];
+        work = data;
+        std::cout << "sort copy:           " << millisecondsFor([&] {
+            std::sort(work.begin(), work.end(), std::greater<double>());
+            fromSort.assign(work.begin(), work.begin() + k);
+        }) << " ms\n";
+        work = data;
+        std::cout << "std::partial_sort:   " << millisecondsFor([&] {
+            std::partial_sort(work.begin(), work.begin() + k, work.end(), std::greater<double>());
+        }) << " ms\n";
+        work = data;
+        std::cout << "std::nth_element:    " << millisecondsFor([&] {
+            std::nth_element(work.begin(), work.begin() + n / 2, work.end());
+        }) << " ms (median)\n";
+        work = data;
+        double median = 0.0;
+        std::cout << "Floyd-Rivest:        " << millisecondsFor([&] {
+            median = SelectionUtils::median(work.data(), size);
+        }) << " ms (median)\n";
+        std::cout << "filtered topK:       " << millisecondsFor([&] {
+            fromTopK = SelectionUtils::topK(data.data(), size, k);
+        }) << " ms\n";
+        std::cout << "parallel topK (" << hardware << "): " << millisecondsFor([&] {
+            fromParallel = SelectionUtils::topKParallel(data.data(), size, k, hardware);
+        }) << " ms\n";
+        work = data;
+        std::vector<double> qs = {0.5, 0.9, 0.99, 0.999}, out;
+        std::cout << "4 quantiles:         " << millisecondsFor([&] {
+            SelectionUtils::quantiles(work.data(), size, qs, out);
+        }) << " ms\n";
+        std::nth_element(data.begin(), data.begin() + (n - 1) / 2, data.end());
+        ok = ok && fromTopK == fromSort && fromParallel == fromSort &&
+             median == data[(n - 1) / 2];
+    }
+    std::cout << "\nall results agree: " << (ok ? "yes" : "NO") << "\n";
+    return ok ? 0 : 1;
+}
+
+// === Program Design Notes ===
+// - NaN compares false with everything; filter NaNs out first if the data may hold them.
+// - The top-K buffer holds max(2K, 4096) values, so memory stays O(K) per thread no
+//   matter how large the input is.
+// - At 10^9 doubles the input alone is 8 GB; pass the size as the first argument once the
+//   machine has room.
+
+// === End of File ===
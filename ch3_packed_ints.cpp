@@ -0,0 +1,566 @@
+/**
+ * @file ch3_packed_ints.cpp
+ * @brief Bit-packed integer arrays: fixed-width integers taken one step further.
+ *
+ * Build: g++ -std=c++17 -O2 ch3_packed_ints.cpp -o ch3_packed_ints
+ *
+ * Topic: Compressed Integer Columns
+ *
+ * ch3.cpp's demonstrate_fixed_width_integers() shows that int8_t and uint32_t have
+ * guaranteed sizes. Real data rarely needs a whole int: values that fit in 7-12 bits are
+ * stored in 32, and every scan moves 3-4x more memory than it has to. This program stores
+ * such columns with exactly as many bits as each block of 128 values needs.
+ *
+ * This program includes:
+ * - Frame-of-reference (FOR) coding: each block stores its minimum once, then every value
+ *   as an unsigned offset from it, bit-packed with the smallest width that fits.
+ * - Delta coding for sorted data: each value is stored as the distance to the value four
+ *   positions earlier, which keeps the four SIMD lanes independent.
+ * - SIMD unpack (SSE2 or NEON, scalar fallback) with one specialization per bit width.
+ * - Random access by index without decoding the block.
+ * - sum/min/max/countInRange that work block by block: min/max come from per-block
+ *   headers, and sum/count unpack into registers without writing the values out, for
+ *   both codecs (delta blocks keep their per-lane running sums in registers).
+ *
+ * Key Attributes:
+ * - Block: 128 values, stored as 4 interleaved lanes of 32 values each.
+ * - Bit width: 0-32 bits, chosen per block from the largest offset.
+ * - Header: base, min, max, bit width and word offset per block.
+ *
+ * Problem-Solving Mindset:
+ * - Memory bandwidth, not arithmetic, is usually the limit for scans.
+ * - Pick the representation from the data (range, sortedness), not from the type name.
+ * - Keep summaries (min/max per block) so whole blocks can be answered or skipped.
+ */
+
+// === Simulated Header File: packed_ints.hpp ===
+#ifndef PACKED_INTS_HPP
+#define PACKED_INTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace PackedInts {
+const int BLOCK_SIZE = 128;
+const int LANES = 4;
+
+enum class Codec {
+    FrameOfReference, // any data
+    Delta             // non-decreasing data
+};
+
+class PackedIntArray {
+public:
+    PackedIntArray(const int* values, int size, Codec codec = Codec::FrameOfReference);
+
+    int size() const { return count; }
+    Codec codec() const { return mode; }
+    int get(int index) const;
+    void decode(int* out) const;
+
+    long long sum() const;
+    int min() const;
+    int max() const;
+    int countInRange(int lo, int hi) const; // inclusive bounds
+
+    size_t bytes() const; // packed words plus block headers
+
+private:
+    struct BlockHeader {
+        int32_t base;        // FOR: block minimum; Delta: first value of the block
+        int32_t minValue;
+        int32_t maxValue;
+        uint32_t wordOffset; // first packed word of the block
+        uint8_t bits;
+    };
+
+    int count;
+    Codec mode;
+    std::vector<BlockHeader> headers;
+    std::vector<uint32_t> words;
+
+    int valuesInBlock(size_t block) const;
+    void decodeBlock(size_t block, int32_t* out) const;
+    template <typename Fn>
+    void forEachOffsets(size_t block, Fn fn) const;
+};
+} // namespace PackedInts
+
+#endif // PACKED_INTS_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <random>
+#include <string>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// === Simulated Header File: simd_lanes.hpp ===
+// Four 32-bit lanes with just the operations the unpacker needs.
+namespace PackedInts {
+#if defined(__SSE2__)
+typedef __m128i Lanes;
+inline Lanes loadLanes(const uint32_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void storeLanes(uint32_t* p, Lanes v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+inline Lanes splat(uint32_t x) { return _mm_set1_epi32(static_cast<int>(x)); }
+inline Lanes addLanes(Lanes a, Lanes b) { return _mm_add_epi32(a, b); }
+inline Lanes andLanes(Lanes a, Lanes b) { return _mm_and_si128(a, b); }
+inline Lanes orLanes(Lanes a, Lanes b) { return _mm_or_si128(a, b); }
+inline Lanes shiftRight(Lanes v, int s) { return _mm_srli_epi32(v, s); }
+inline Lanes shiftLeft(Lanes v, int s) { return _mm_slli_epi32(v, s); }
+// 1 in each lane where lo <= v <= lo + span (unsigned)
+inline Lanes inRange(Lanes v, Lanes lo, Lanes span) {
+    const __m128i sign = _mm_set1_epi32(INT_MIN);
+    __m128i x = _mm_xor_si128(_mm_sub_epi32(v, lo), sign);
+    __m128i outside = _mm_cmpgt_epi32(x, _mm_xor_si128(span, sign));
+    return _mm_add_epi32(_mm_set1_epi32(1), outside);
+}
+#elif defined(__ARM_NEON)
+typedef uint32x4_t Lanes;
+inline Lanes loadLanes(const uint32_t* p) { return vld1q_u32(p); }
+inline void storeLanes(uint32_t* p, Lanes v) { vst1q_u32(p, v); }
+inline Lanes splat(uint32_t x) { return vdupq_n_u32(x); }
+inline Lanes addLanes(Lanes a, Lanes b) { return vaddq_u32(a, b); }
+inline Lanes andLanes(Lanes a, Lanes b) { return vandq_u32(a, b); }
+inline Lanes orLanes(Lanes a, Lanes b) { return vorrq_u32(a, b); }
+inline Lanes shiftRight(Lanes v, int s) { return vshlq_u32(v, vdupq_n_s32(-s)); }
+inline Lanes shiftLeft(Lanes v, int s) { return vshlq_u32(v, vdupq_n_s32(s)); }
+inline Lanes inRange(Lanes v, Lanes lo, Lanes span) {
+    return vshrq_n_u32(vcleq_u32(vsubq_u32(v, lo), span), 31);
+}
+#else
+struct Lanes {
+    uint32_t v[LANES];
+};
+inline Lanes loadLanes(const uint32_t* p) { Lanes r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+inline void storeLanes(uint32_t* p, Lanes x) { std::memcpy(p, x.v, sizeof(x.v)); }
+inline Lanes splat(uint32_t x) { return Lanes{{x, x, x, x}}; }
+#define PACKED_INTS_LANEWISE(name, expr)                          \
+    inline Lanes name(Lanes a, Lanes b) {                         \
+        Lanes r;                                                  \
+        for (int l = 0; l < LANES; ++l) r.v[l] = (expr);          \
+        return r;                                                 \
+    }
+PACKED_INTS_LANEWISE(addLanes, a.v[l] + b.v[l])
+PACKED_INTS_LANEWISE(andLanes, a.v[l] & b.v[l])
+PACKED_INTS_LANEWISE(orLanes, a.v[l] | b.v[l])
+#undef PACKED_INTS_LANEWISE
+inline Lanes shiftRight(Lanes a, int s) { for (uint32_t& x : a.v) x >>= s; return a; }
+inline Lanes shiftLeft(Lanes a, int s) { for (uint32_t& x : a.v) x <<= s; return a; }
+inline Lanes inRange(Lanes v, Lanes lo, Lanes span) {
+    Lanes r;
+    for (int l = 0; l < LANES; ++l) r.v[l] = v.v[l] - lo.v[l] <= span.v[l];
+    return r;
+}
+#endif
+
+// Horizontal sum into 64 bits
+inline uint64_t sumLanes(Lanes v) {
+    uint32_t tmp[LANES];
+    storeLanes(tmp, v);
+    return static_cast<uint64_t>(tmp[0]) + tmp[1] + tmp[2] + tmp[3];
+}
+} // namespace PackedInts
+
+// === Function Definitions: bit-width kernels ===
+namespace PackedInts {
+// Value i of a block lives in lane i % 4 at position i / 4. Each lane is a stream of
+// 32 * B bits, and word w of lane l is stored at in[4 * w + l], so one 128-bit load
+// fetches the same word of all four lanes. With B known at compile time every shift
+// below is a constant and the loop fully unrolls.
+template <int B, typename Sink>
+inline void unpackLanes(const uint32_t* in, Sink& sink) {
+    if (B == 0) {
+        for (int j = 0; j < BLOCK_SIZE / LANES; ++j) sink(j, splat(0));
+        return;
+    }
+    const Lanes mask = splat(B == 32 ? 0xFFFFFFFFu : (1u << (B % 32)) - 1);
+    for (int j = 0; j < BLOCK_SIZE / LANES; ++j) {
+        const int offset = j * B;
+        const int word = offset / 32;
+        const int shift = offset % 32;
+        Lanes v = shiftRight(loadLanes(in + LANES * word), shift);
+        if (shift + B > 32) {
+            v = orLanes(v, shiftLeft(loadLanes(in + LANES * (word + 1)), 32 - shift));
+        }
+        sink(j, andLanes(v, mask));
+    }
+}
+
+// Runtime bit width -> compile-time kernel
+template <typename Sink, int B = 0>
+inline void unpackBlockWith(int bits, const uint32_t* in, Sink& sink) {
+    if constexpr (B <= 32) {
+        if (bits == B) {
+            unpackLanes<B>(in, sink);
+        } else {
+            unpackBlockWith<Sink, B + 1>(bits, in, sink);
+        }
+    }
+}
+
+// Bits needed to hold x
+inline int bitWidth(uint32_t x) {
+    return x == 0 ? 0 : 32 - __builtin_clz(x);
+}
+
+// Pack 128 unsigned values with `bits` bits each into the interleaved lane layout
+void packBlock(const uint32_t* values, int bits, uint32_t* out) {
+    std::fill(out, out + LANES * bits, 0u);
+    for (int i = 0; i < BLOCK_SIZE; ++i) {
+        const int lane = i % LANES;
+        const int offset = (i / LANES) * bits;
+        const int word = offset / 32;
+        const int shift = offset % 32;
+        if (bits == 0) continue;
+        out[LANES * word + lane] |= values[i] << shift;
+        if (shift + bits > 32) {
+            out[LANES * (word + 1) + lane] |= values[i] >> (32 - shift);
+        }
+    }
+}
+} // namespace PackedInts
+
+// === Function Definitions: PackedIntArray ===
+namespace PackedInts {
+PackedIntArray::PackedIntArray(const int* values, int size, Codec codec)
+    : count(size > 0 ? size : 0), mode(codec) {
+    if (size < 0) {
+        std::cerr << "Error: Invalid array size\n";
+    }
+    if (mode == Codec::Delta && !std::is_sorted(values, values + count)) {
+        std::cerr << "Error: Delta coding needs sorted input, using frame-of-reference\n";
+        mode = Codec::FrameOfReference;
+    }
+
+    uint32_t raw[BLOCK_SIZE];
+    for (int start = 0; start < count; start += BLOCK_SIZE) {
+        const int n = std::min(BLOCK_SIZE, count - start);
+        const int* block = values + start;
+        BlockHeader header;
+        header.minValue = *std::min_element(block, block + n);
+        header.maxValue = *std::max_element(block, block + n);
+
+        if (mode == Codec::FrameOfReference) {
+            // Pad the tail with the minimum, i.e. offset 0
+            header.base = header.minValue;
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                int32_t v = i < n ? block[i] : header.base;
+                raw[i] = static_cast<uint32_t>(v) - static_cast<uint32_t>(header.base);
+            }
+        } else {
+            // Pad the tail by repeating the last value, i.e. delta 0
+            header.base = block[0];
+            for (int i = 0; i < BLOCK_SIZE; ++i) {
+                int32_t v = block[std::min(i, n - 1)];
+                int32_t prev = i < LANES ? header.base : block[std::min(i - LANES, n - 1)];
+                raw[i] = static_cast<uint32_t>(v) - static_cast<uint32_t>(prev);
+            }
+        }
+
+        uint32_t widest = 0;
+        for (uint32_t r : raw) widest |= r;
+        header.bits = static_cast<uint8_t>(bitWidth(widest));
+        header.wordOffset = static_cast<uint32_t>(words.size());
+        words.resize(words.size() + LANES * header.bits);
+        packBlock(raw, header.bits, words.data() + header.wordOffset);
+        headers.push_back(header);
+    }
+    // One spare lane-word so the unpacker's look-ahead load never leaves the buffer
+    words.resize(words.size() + LANES, 0u);
+}
+
+int PackedIntArray::valuesInBlock(size_t block) const {
+    return std::min(BLOCK_SIZE, count - static_cast<int>(block) * BLOCK_SIZE);
+}
+
+size_t PackedIntArray::bytes() const {
+    return words.size() * sizeof(uint32_t) + headers.size() * sizeof(BlockHeader);
+}
+
+// Decode one whole block (128 values, including padding)
+void PackedIntArray::decodeBlock(size_t block, int32_t* out) const {
+    const BlockHeader& h = headers[block];
+    const uint32_t* in = words.data() + h.wordOffset;
+    uint32_t* dst = reinterpret_cast<uint32_t*>(out);
+    if (mode == Codec::FrameOfReference) {
+        const Lanes base = splat(static_cast<uint32_t>(h.base));
+        auto store = [&](int j, Lanes v) { storeLanes(dst + LANES * j, addLanes(v, base)); };
+        unpackBlockWith(h.bits, in, store);
+    } else {
+        // Running sum per lane turns the stride-4 deltas back into values
+        Lanes acc = splat(static_cast<uint32_t>(h.base));
+        auto store = [&](int j, Lanes v) {
+            acc = addLanes(acc, v);
+            storeLanes(dst + LANES * j, acc);
+        };
+        unpackBlockWith(h.bits, in, store);
+    }
+}
+
+// Calls fn(offsets) for each group of four values of a block, as value - base. FOR
+// offsets come straight out of the unpacker; delta offsets are a running sum per lane
+// kept in a register. Either way nothing is written to memory.
+template <typename Fn>
+void PackedIntArray::forEachOffsets(size_t block, Fn fn) const {
+    const BlockHeader& h = headers[block];
+    const uint32_t* in = words.data() + h.wordOffset;
+    if (mode == Codec::FrameOfReference) {
+        auto sink = [&](int, Lanes v) { fn(v); };
+        unpackBlockWith(h.bits, in, sink);
+    } else {
+        Lanes acc = splat(0);
+        auto sink = [&](int, Lanes v) {
+            acc = addLanes(acc, v);
+            fn(acc);
+        };
+        unpackBlockWith(h.bits, in, sink);
+    }
+}
+
+void PackedIntArray::decode(int* out) const {
+    int32_t buffer[BLOCK_SIZE];
+    for (size_t b = 0; b < headers.size(); ++b) {
+        decodeBlock(b, buffer);
+        std::memcpy(out + b * BLOCK_SIZE, buffer, valuesInBlock(b) * sizeof(int32_t));
+    }
+}
+
+// Extract one value straight from the packed bits
+int PackedIntArray::get(int index) const {
+    if (index < 0 || index >= count) {
+        std::cerr << "Error: Index out of range\n";
+        return 0;
+    }
+    const BlockHeader& h = headers[index / BLOCK_SIZE];
+    const uint32_t* in = words.data() + h.wordOffset;
+    const int i = index % BLOCK_SIZE;
+    const int lane = i % LANES;
+    const int bits = h.bits;
+    const uint32_t mask = bits == 32 ? 0xFFFFFFFFu : (1u << bits) - 1;
+
+    auto field = [&](int position) -> uint32_t {
+        if (bits == 0) return 0;
+        const int offset = position * bits;
+        const int word = offset / 32;
+        const int shift = offset % 32;
+        uint64_t pair = in[LANES * word + lane];
+        if (shift + bits > 32) pair |= static_cast<uint64_t>(in[LANES * (word + 1) + lane]) << 32;
+        return static_cast<uint32_t>(pair >> shift) & mask;
+    };
+
+    uint32_t value = static_cast<uint32_t>(h.base);
+    if (mode == Codec::FrameOfReference) {
+        value += field(i / LANES);
+    } else {
+        for (int position = 0; position <= i / LANES; ++position) value += field(position);
+    }
+    return static_cast<int32_t>(value);
+}
+
+int PackedIntArray::min() const {
+    if (count == 0) {
+        std::cerr << "Error: Invalid array size\n";
+        return 0;
+    }
+    int result = INT_MAX;
+    for (const BlockHeader& h : headers) result = std::min(result, static_cast<int>(h.minValue));
+    return result;
+}
+
+int PackedIntArray::max() const {
+    if (count == 0) {
+        std::cerr << "Error: Invalid array size\n";
+        return 0;
+    }
+    int result = INT_MIN;
+    for (const BlockHeader& h : headers) result = std::max(result, static_cast<int>(h.maxValue));
+    return result;
+}
+
+// sum = 128 * base + sum of offsets. Offsets are added in 32-bit lanes, which cannot
+// overflow while every offset is below 2^27 (32 per lane): a FOR width of at most 27 bits,
+// or a delta block whose max - min is below 2^27 (its base is its minimum).
+long long PackedIntArray::sum() const {
+    long long total = 0;
+    int32_t buffer[BLOCK_SIZE];
+    for (size_t b = 0; b < headers.size(); ++b) {
+        const BlockHeader& h = headers[b];
+        const int n = valuesInBlock(b);
+        const bool fits = mode == Codec::FrameOfReference
+                              ? h.bits <= 27
+                              : static_cast<uint32_t>(h.maxValue) -
+                                        static_cast<uint32_t>(h.minValue) < (1u << 27);
+        if (n == BLOCK_SIZE && fits) {
+            Lanes acc = splat(0);
+            forEachOffsets(b, [&](Lanes v) { acc = addLanes(acc, v); });
+            total += static_cast<long long>(h.base) * BLOCK_SIZE +
+                     static_cast<long long>(sumLanes(acc));
+        } else {
+            decodeBlock(b, buffer);
+            for (int i = 0; i < n; ++i) total += buffer[i];
+        }
+    }
+    return total;
+}
+
+// Whole blocks are counted or skipped from their min/max; only straddling blocks are
+// unpacked, and they are compared in the offset domain without adding the base.
+int PackedIntArray::countInRange(int lo, int hi) const {
+    if (lo > hi) return 0;
+    int total = 0;
+    int32_t buffer[BLOCK_SIZE];
+    for (size_t b = 0; b < headers.size(); ++b) {
+        const BlockHeader& h = headers[b];
+        const int n = valuesInBlock(b);
+        if (h.maxValue < lo || h.minValue > hi) continue;
+        if (h.minValue >= lo && h.maxValue <= hi) {
+            total += n;
+            continue;
+        }
+        if (n == BLOCK_SIZE) {
+            const int32_t clampLo = std::max(lo, static_cast<int>(h.minValue));
+            const int32_t clampHi = std::min(hi, static_cast<int>(h.maxValue));
+            const Lanes loOffset =
+                splat(static_cast<uint32_t>(clampLo) - static_cast<uint32_t>(h.base));
+            const Lanes span =
+                splat(static_cast<uint32_t>(clampHi) - static_cast<uint32_t>(clampLo));
+            Lanes hits = splat(0);
+            forEachOffsets(b, [&](Lanes v) { hits = addLanes(hits, inRange(v, loOffset, span)); });
+            total += static_cast<int>(sumLanes(hits));
+        } else {
+            decodeBlock(b, buffer);
+            for (int i = 0; i < n; ++i) total += buffer[i] >= lo && buffer[i] <= hi;
+        }
+    }
+    return total;
+}
+} // namespace PackedInts
+
+// === Utility Functions ===
+// Time a callable in milliseconds
+template <typename Fn>
+double millisecondsFor(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/**
+ * @brief Checks every operation of a packed array against the plain array.
+ * @return True if all results match.
+ */
+bool verify(const std::vector<int>& plain, const PackedInts::PackedIntArray& packed,
+            const std::string& label) {
+    bool ok = packed.size() == static_cast<int>(plain.size());
+    std::vector<int> decoded(plain.size());
+    packed.decode(decoded.data());
+    ok = ok && decoded == plain;
+    for (size_t i = 0; ok && i < plain.size(); i += 1 + i / 7) {
+        ok = packed.get(static_cast<int>(i)) == plain[i];
+    }
+    long long sum = 0;
+    for (int v : plain) sum += v;
+    ok = ok && packed.sum() == sum;
+    if (!plain.empty()) {
+        ok = ok && packed.min() == *std::min_element(plain.begin(), plain.end());
+        ok = ok && packed.max() == *std::max_element(plain.begin(), plain.end());
+        int lo = plain[plain.size() / 3], hi = lo > INT_MAX - 1000 ? INT_MAX : lo + 1000;
+        int expected = static_cast<int>(std::count_if(plain.begin(), plain.end(),
+                                                      [&](int v) { return v >= lo && v <= hi; }));
+        ok = ok && packed.countInRange(lo, hi) == expected;
+    }
+    std::cout << label << ": " << (ok ? "pass" : "FAIL") << "\n";
+    return ok;
+}
+
+/**
+ * @brief Demonstrates the packed array on a 12-bit column and a sorted column.
+ */
+int main(int argc, char* argv[]) {
+    std::cout << "=== Bit-Packed Integer Arrays ===\n\n";
+    const int size = argc > 1 ? std::atoi(argv[1]) : 1 << 22;
+    std::mt19937 rng(3);
+    bool ok = true;
+
+    // Correctness on awkward shapes: empty, partial block, negatives, full 32-bit range
+    std::vector<int> tiny = {5, -3, 7};
+    std::vector<int> extremes = {INT_MIN, INT_MAX, 0, -1, 1};
+    std::vector<int> empty;
+    ok = verify(tiny, PackedInts::PackedIntArray(tiny.data(), 3), "partial block") && ok;
+    ok = verify(extremes, PackedInts::PackedIntArray(extremes.data(), 5), "32-bit range") && ok;
+    ok = verify(empty, PackedInts::PackedIntArray(empty.data(), 0), "empty") && ok;
+
+    // A typical column: values that fit in 12 bits, stored as full ints today
+    std::vector<int> column(size);
+    std::uniform_int_distribution<int> valueDist(1000, 1000 + 4095);
+    for (int& v : column) v = valueDist(rng);
+    PackedInts::PackedIntArray packed(column.data(), size);
+    ok = verify(column, packed, "12-bit column") && ok;
+
+    // A sorted column (e.g. timestamps) with small gaps
+    std::vector<int> sorted(size);
+    std::uniform_int_distribution<int> gapDist(0, 100);
+    int current = -500000;
+    for (int& v : sorted) v = current += gapDist(rng);
+    PackedInts::PackedIntArray delta(sorted.data(), size, PackedInts::Codec::Delta);
+    PackedInts::PackedIntArray sortedFor(sorted.data(), size);
+    ok = verify(sorted, delta, "sorted column, delta") && ok;
+
+    // Sorted with gaps so wide that some delta blocks span more than 2^27
+    std::vector<int> wide(1024);
+    std::uniform_int_distribution<int> wideGap(0, 1 << 22);
+    current = INT_MIN;
+    for (int& v : wide) v = current += wideGap(rng);
+    ok = verify(wide, PackedInts::PackedIntArray(wide.data(), 1024, PackedInts::Codec::Delta),
+                "wide sorted column, delta") && ok;
+
+    std::cout << "\n=== Size ===\n";
+    std::cout << "plain int:            " << size * sizeof(int) / 1024 << " KiB\n";
+    std::cout << "12-bit column packed: " << packed.bytes() / 1024 << " KiB\n";
+    std::cout << "sorted, FOR:          " << sortedFor.bytes() / 1024 << " KiB\n";
+    std::cout << "sorted, delta:        " << delta.bytes() / 1024 << " KiB\n";
+
+    std::cout << "\n=== Speed (12-bit column, " << size << " values) ===\n";
+    long long plainSum = 0, packedSum = 0;
+    int plainCount = 0, packedCount = 0;
+    std::vector<int> out(size);
+    std::cout << "plain sum:       " << millisecondsFor([&] {
+        for (int v : column) plainSum += v;
+    }) << " ms\n";
+    std::cout << "packed sum:      " << millisecondsFor([&] { packedSum = packed.sum(); })
+              << " ms\n";
+    std::cout << "plain count:     " << millisecondsFor([&] {
+        for (int v : column) plainCount += v >= 2000 && v <= 3000;
+    }) << " ms\n";
+    std::cout << "packed count:    " << millisecondsFor([&] {
+        packedCount = packed.countInRange(2000, 3000);
+    }) << " ms\n";
+    std::cout << "packed decode:   " << millisecondsFor([&] { packed.decode(out.data()); })
+              << " ms\n";
+    long long deltaSum = 0, sortedSum = 0;
+    int deltaCount = 0, sortedCount = 0;
+    std::cout << "delta sum:       " << millisecondsFor([&] { deltaSum = delta.sum(); })
+              << " ms (sorted column)\n";
+    std::cout << "delta count:     " << millisecondsFor([&] {
+        deltaCount = delta.countInRange(sorted[size / 3], sorted[size / 3] + 1000);
+    }) << " ms (sorted column)\n";
+    for (int v : sorted) {
+        sortedSum += v;
+        sortedCount += v >= sorted[size / 3] && v <= sorted[size / 3] + 1000;
+    }
+    ok = ok && plainSum == packedSum && plainCount == packedCount && deltaSum == sortedSum &&
+         deltaCount == sortedCount;
+    std::cout << "results agree: " << (ok ? "yes" : "NO") << "\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,297 @@
+// File: ch8_search.cpp
+// Purpose: Grows ch8.cpp's "scan until arr[i] >= 5, then goto out of the loop" into a small
+//          search subsystem for the question "where is the first element >= x?".
+//          Build: g++ -std=c++17 -O2 ch8_search.cpp -o ch8_search   (add -march=native for AVX2)
+
+// === Topic Overview ===
+// This program covers:
+// - A SIMD linear scan for small or unsorted arrays (the ch8.cpp loop, 8 elements at a time).
+// - An Eytzinger (BFS-order) copy of a sorted array with a branchless lower_bound that
+//   prefetches four levels ahead.
+// - A batched query API that walks many searches through the tree in lockstep, so the
+//   cache misses of different queries overlap instead of queueing up.
+// - A benchmark against std::lower_bound.
+
+// === Significance in Computer Science ===
+// Binary search does few comparisons but each one is a cache miss whose address depends
+// on the previous comparison. Storing the implicit tree in BFS order puts the hot top
+// levels together and makes the next few addresses predictable, so they can be prefetched;
+// interleaving independent queries fills the remaining gaps. The answer is identical to
+// std::lower_bound: only the memory layout changes.
+
+// === Simulated Header File: search_utils.hpp ===
+#ifndef SEARCH_UTILS_HPP
+#define SEARCH_UTILS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SearchUtils {
+// Index of the first element >= x in any (unsorted) array, or size if there is none
+int findFirstAtLeast(const int* arr, int size, int x);
+
+// Read-only sorted-array index laid out in Eytzinger order
+class EytzingerIndex {
+public:
+    explicit EytzingerIndex(const std::vector<int>& sorted);
+    ~EytzingerIndex();
+    EytzingerIndex(const EytzingerIndex&) = delete;
+    EytzingerIndex& operator=(const EytzingerIndex&) = delete;
+
+    // Same result as std::lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin()
+    int lowerBound(int x) const;
+    // lowerBound() for many queries, interleaved to hide memory latency
+    void lowerBoundBatch(const int* queries, int count, int* results) const;
+    int size() const { return count; }
+
+private:
+    int count;      // number of real elements
+    int levels;     // tree height; every search takes exactly this many steps
+    size_t slots;   // 2^levels, padded with INT_MAX so the tree is complete
+    int* keys;      // keys[1..slots-1] in BFS order (64-byte aligned)
+    void build(const std::vector<int>& sorted, int& next, size_t k);
+};
+} // namespace SearchUtils
+
+#endif // SEARCH_UTILS_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// === Preprocessor Directives ===
+#define CACHE_LINE_INTS 16 // 64-byte line / 4-byte int
+#define BATCH_WIDTH 16     // queries walked through the tree together
+
+// === Function Definitions: SearchUtils ===
+namespace SearchUtils {
+// Linear "first >= x". The vector loop checks 8 elements per step and leaves the loop on
+// the first hit, like the goto in ch8.cpp; the scalar loop handles the tail.
+int findFirstAtLeast(const int* arr, int size, int x) {
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256i limit = _mm256_set1_epi32(x);
+    for (; i + 8 <= size; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(arr + i));
+        int below = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(limit, v)));
+        if (below != 0xFF) return i + __builtin_ctz(~below & 0xFF);
+    }
+#elif defined(__SSE2__)
+    const __m128i limit = _mm_set1_epi32(x);
+    for (; i + 8 <= size; i += 8) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arr + i));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(arr + i + 4));
+        int below = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(lo, limit))) |
+                    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(hi, limit))) << 4;
+        if (below != 0xFF) return i + __builtin_ctz(~below & 0xFF);
+    }
+#elif defined(__ARM_NEON)
+    const int32x4_t limit = vdupq_n_s32(x);
+    for (; i + 8 <= size; i += 8) {
+        uint16x4_t lo = vmovn_u32(vcgeq_s32(vld1q_s32(arr + i), limit));
+        uint16x4_t hi = vmovn_u32(vcgeq_s32(vld1q_s32(arr + i + 4), limit));
+        uint8x8_t hits = vmovn_u16(vcombine_u16(lo, hi));
+        uint64_t bits = vget_lane_u64(vreinterpret_u64_u8(hits), 0);
+        if (bits != 0) return i + __builtin_ctzll(bits) / 8;
+    }
+#endif
+    for (; i < size; ++i) {
+        if (arr[i] >= x) return i;
+    }
+    return size;
+}
+
+EytzingerIndex::EytzingerIndex(const std::vector<int>& sorted)
+    : count(static_cast<int>(sorted.size())), levels(0), slots(1) {
+    // Results are ints and the descent index is 32-bit: 2^31 - 1 elements at most
+    if (sorted.size() > static_cast<size_t>(INT_MAX)) {
+        std::cerr << "Error: Too many elements for EytzingerIndex\n";
+        count = 0;
+    }
+    while (slots <= static_cast<size_t>(count)) {
+        slots <<= 1;
+        ++levels;
+    }
+    // Prefetches near the bottom point past the end; that is fine, prefetch never faults
+    size_t bytes = (slots * sizeof(int) + 63) / 64 * 64;
+    keys = static_cast<int*>(std::aligned_alloc(64, bytes));
+    if (keys == nullptr) throw std::bad_alloc();
+    std::fill(keys, keys + bytes / sizeof(int), INT_MAX);
+    int next = 0;
+    build(sorted, next, 1);
+}
+
+EytzingerIndex::~EytzingerIndex() {
+    std::free(keys);
+}
+
+// In-order walk of the implicit tree hands out the sorted values in order. Slots past the
+// real data keep INT_MAX, which never compares < x, so searches simply go left there.
+void EytzingerIndex::build(const std::vector<int>& sorted, int& next, size_t k) {
+    if (k >= slots) return;
+    build(sorted, next, 2 * k);
+    if (next < count) keys[k] = sorted[next++];
+    build(sorted, next, 2 * k + 1);
+}
+
+// Branchless descent: go right while keys[k] < x. The tree is complete, so after `levels`
+// steps k - slots is the gap between in-order keys that x falls into, which is exactly the
+// number of keys < x. Padding is INT_MAX and never < x, so no rank table is needed.
+int EytzingerIndex::lowerBound(int x) const {
+    unsigned k = 1;
+    for (int level = 0; level < levels; ++level) {
+        __builtin_prefetch(keys + static_cast<size_t>(k) * CACHE_LINE_INTS);
+        k = 2 * k + (keys[k] < x);
+    }
+    return static_cast<int>(k - slots);
+}
+
+// Every search has the same length, so a group of queries can advance one level at a time
+// together; the loads of one level are independent and go out to memory in parallel.
+void EytzingerIndex::lowerBoundBatch(const int* queries, int total, int* results) const {
+    unsigned k[BATCH_WIDTH];
+    int done = 0;
+    for (; done + BATCH_WIDTH <= total; done += BATCH_WIDTH) {
+        const int* q = queries + done;
+        for (int j = 0; j < BATCH_WIDTH; ++j) k[j] = 1;
+        for (int level = 0; level < levels; ++level) {
+            for (int j = 0; j < BATCH_WIDTH; ++j) {
+                __builtin_prefetch(keys + static_cast<size_t>(k[j]) * CACHE_LINE_INTS);
+                k[j] = 2 * k[j] + (keys[k[j]] < q[j]);
+            }
+        }
+        for (int j = 0; j < BATCH_WIDTH; ++j) {
+            results[done + j] = static_cast<int>(k[j] - slots);
+        }
+    }
+    for (; done < total; ++done) {
+        results[done] = lowerBound(queries[done]);
+    }
+}
+} // namespace SearchUtils
+
+// === Utility Functions ===
+// Time a callable and return nanoseconds per query
+template <typename Fn>
+double nanosPerQuery(Fn fn, int queryCount) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / queryCount;
+}
+
+// Compare every strategy on one array size; returns false if any result disagrees
+bool runBenchmark(int size, int queryCount, std::mt19937& rng) {
+    std::vector<int> sorted(size);
+    std::uniform_int_distribution<int> valueDist(0, INT_MAX / 2);
+    for (int& v : sorted) v = valueDist(rng);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<int> queries(queryCount);
+    for (int& q : queries) q = valueDist(rng);
+
+    SearchUtils::EytzingerIndex index(sorted);
+    std::vector<int> expected(queryCount), single(queryCount), batched(queryCount);
+    long long checksum = 0;
+
+    double stdNs = nanosPerQuery([&] {
+        for (int i = 0; i < queryCount; ++i) {
+            expected[i] = static_cast<int>(
+                std::lower_bound(sorted.begin(), sorted.end(), queries[i]) - sorted.begin());
+        }
+    }, queryCount);
+    double eytzNs = nanosPerQuery([&] {
+        for (int i = 0; i < queryCount; ++i) single[i] = index.lowerBound(queries[i]);
+    }, queryCount);
+    double batchNs = nanosPerQuery([&] {
+        index.lowerBoundBatch(queries.data(), queryCount, batched.data());
+    }, queryCount);
+
+    bool ok = expected == single && expected == batched;
+    for (int r : batched) checksum += r;
+
+    std::cout << "n = " << size << ": std::lower_bound " << stdNs << " ns, eytzinger "
+              << eytzNs << " ns, eytzinger batch " << batchNs << " ns"
+              << (ok ? "" : "  MISMATCH") << " (checksum " << checksum << ")\n";
+    return ok;
+}
+
+// === Program Design: Main Function ===
+int main(int argc, char* argv[]) {
+    // ch8.cpp's example, without the goto
+    int arr[10];
+    for (int i = 0; i < 10; i++) arr[i] = i + 1;
+    int hit = SearchUtils::findFirstAtLeast(arr, 10, 5);
+    std::cout << "first element >= 5 is arr[" << hit << "] = " << arr[hit] << "\n";
+
+    // Linear kernel against the plain loop on an unsorted array
+    std::mt19937 rng(8);
+    std::vector<int> unsorted(1000);
+    std::uniform_int_distribution<int> smallDist(0, 999);
+    for (int& v : unsorted) v = smallDist(rng);
+    bool ok = true;
+    for (int x = -1; x <= 1001; ++x) {
+        int expected = static_cast<int>(unsorted.size());
+        for (size_t i = 0; i < unsorted.size(); ++i) {
+            if (unsorted[i] >= x) {
+                expected = static_cast<int>(i);
+                break;
+            }
+        }
+        ok = ok && SearchUtils::findFirstAtLeast(unsorted.data(), 1000, x) == expected;
+    }
+    std::cout << "linear kernel matches scalar loop: " << (ok ? "yes" : "NO") << "\n";
+
+    // Edge cases for the index: empty, single element, duplicates, out-of-range queries
+    std::vector<int> dups = {1, 3, 3, 3, 7};
+    SearchUtils::EytzingerIndex empty(std::vector<int>{});
+    SearchUtils::EytzingerIndex small(dups);
+    for (int x : {INT_MIN, 0, 1, 2, 3, 4, 7, 8, INT_MAX}) {
+        int expected = static_cast<int>(std::lower_bound(dups.begin(), dups.end(), x) -
+                                        dups.begin());
+        ok = ok && small.lowerBound(x) == expected && empty.lowerBound(x) == 0;
+    }
+    // Every size up to 100, so most trees end with a partly padded level
+    for (int n = 0; n <= 100 && ok; ++n) {
+        std::vector<int> sorted(n);
+        for (int& v : sorted) v = smallDist(rng) / 10;
+        std::sort(sorted.begin(), sorted.end());
+        SearchUtils::EytzingerIndex index(sorted);
+        for (int x = -1; x <= 101; ++x) {
+            ok = ok && index.lowerBound(x) ==
+                           std::lower_bound(sorted.begin(), sorted.end(), x) - sorted.begin();
+        }
+    }
+    std::cout << "edge cases: " << (ok ? "pass" : "FAIL") << "\n\n";
+
+    int maxSize = argc > 1 ? std::atoi(argv[1]) : 1 << 22;
+    int queryCount = argc > 2 ? std::atoi(argv[2]) : 1 << 20;
+    for (int size = 1 << 10; size <= maxSize; size <<= 3) {
+        ok = runBenchmark(size, queryCount, rng) && ok;
+    }
+    return ok ? 0 : 1;
+}
+
+// === Program Design Notes ===
+// - B+-tree node order (several keys per 64-byte node, searched with SIMD) is the next step
+//   if the prefetch bandwidth of the Eytzinger layout becomes the limit; the public
+//   interface would not change.
+// - Padding the tree to 2^levels - 1 slots costs up to 2x memory but makes every search the
+//   same length, which is what lets the batch API run queries in lockstep.
+
+// === End of File ===
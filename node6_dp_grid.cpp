@@ -0,0 +1,522 @@
+// File: node6_dp_grid.cpp
+// Purpose: A reusable engine for the 2-D dynamic-programming problems of roadmap Node 6
+//          (Unique Paths, Minimum Path Sum, Edit Distance, LCS). The caller writes only the
+//          cell recurrence; the engine owns memory layout, traversal order and threads.
+//          Build: g++ -std=c++17 -O2 -pthread node6_dp_grid.cpp -o node6_dp_grid
+
+// === Topic Overview ===
+// This program covers:
+// - The grid model: cells (i, j) for 0 <= i <= rows, 0 <= j <= cols. Row 0 and column 0
+//   come from a boundary function; every other cell from a recurrence over its up, left
+//   and up-left (diagonal) neighbours.
+// - Rolling edges: only the last row and column of each tile are kept, so memory is
+//   O(rows + cols) instead of O(rows * cols).
+// - Cache tiling: the grid is cut into square tiles that fit in cache; a tile only needs
+//   the bottom row of the tile above and the right column of the tile to its left.
+// - Wavefront parallelism: tiles on the same anti-diagonal do not depend on each other,
+//   so threads take them in parallel, one diagonal at a time.
+// - Optional traceback: 2 bits per cell record which neighbour each cell came from.
+
+// === Significance in Computer Science ===
+// Textbook 2-D DP allocates the whole (m+1) x (n+1) table, which for 50k x 50k is ten
+// gigabytes of int. The recurrences above only look one row back, so that table is never
+// needed unless the caller wants the path. Tiling then keeps the working set in cache and
+// exposes enough independent work for every core.
+
+// === Simulated Header File: dp_grid.hpp ===
+#ifndef DP_GRID_HPP
+#define DP_GRID_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace DPGrid {
+// Which neighbour a cell's value came from
+enum Move : uint8_t {
+    FROM_DIAG = 0,
+    FROM_UP = 1,
+    FROM_LEFT = 2
+};
+
+struct Options {
+    int threads = 1;         // > 1 enables the wavefront
+    int tileSize = 256;      // tile edge in cells (rounded up to a multiple of 4)
+    bool traceback = false;  // store 2 bits per cell and return the path
+};
+
+template <typename T>
+struct Result {
+    T value{};               // dp[rows][cols]
+    std::vector<Move> path;  // moves from (0, 0) to (rows, cols) when traceback is on
+};
+
+// Boundary: T(int i, int j), called for i == 0 or j == 0.
+// Cell:     T(int i, int j, const T& up, const T& left, const T& diag, Move& move)
+template <typename T, typename Boundary, typename Cell>
+Result<T> solve(int rows, int cols, Boundary boundary, Cell cell, Options options = Options());
+} // namespace DPGrid
+
+#endif // DP_GRID_HPP
+
+// === Main Program ===
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+
+// === Function Definitions: DPGrid ===
+namespace DPGrid {
+// 2 bits per interior cell. Column j (1-based) lives at bit pair j - 1 of its row, so a
+// tile whose first column is a multiple of 4 (plus one) owns whole bytes and threads never
+// share a byte.
+class MoveTable {
+public:
+    void reset(int rows, int cols) {
+        stride = (static_cast<size_t>(cols) + 3) / 4;
+        bits.assign(stride * rows, 0);
+    }
+    void set(int i, int j, Move move) {
+        uint8_t& byte = bits[(i - 1) * stride + (j - 1) / 4];
+        const int shift = 2 * ((j - 1) % 4);
+        byte = static_cast<uint8_t>((byte & ~(3 << shift)) | (move << shift));
+    }
+    Move get(int i, int j) const {
+        const uint8_t byte = bits[(i - 1) * stride + (j - 1) / 4];
+        return static_cast<Move>((byte >> (2 * ((j - 1) % 4))) & 3);
+    }
+
+private:
+    size_t stride = 0;
+    std::vector<uint8_t> bits;
+};
+
+// Reusable barrier (std::barrier is C++20)
+class Barrier {
+public:
+    explicit Barrier(int count) : total(count), waiting(0), generation(0) {}
+    void arriveAndWait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        const unsigned long long myGeneration = generation;
+        if (++waiting == total) {
+            waiting = 0;
+            ++generation;
+            cv.notify_all();
+        } else {
+            cv.wait(lock, [&] { return generation != myGeneration; });
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    int total, waiting;
+    unsigned long long generation;
+};
+
+// Compute one tile: rows (r0, r1], columns (c0, c1].
+//   top[k]  = dp[r0][c0 + k]  for k = 0..width   (in: tile above; out: this tile's bottom)
+//   left[k] = dp[r0 + k][c0]  for k = 0..height  (in: tile to the left; out: right column)
+// Both edges include the shared corner dp[r0][c0], so no tile ever needs a third input.
+template <typename T, typename Cell>
+void computeTile(int r0, int r1, int c0, int c1, T* top, T* left, std::vector<T>& scratch,
+                 Cell& cell, MoveTable* moves) {
+    const int width = c1 - c0;
+    const T corner = top[width]; // dp[r0][c1], the next tile's corner
+    scratch.resize(width + 1);
+    T* prev = top;
+    T* cur = scratch.data();
+    for (int i = r0 + 1; i <= r1; ++i) {
+        cur[0] = left[i - r0];
+        for (int k = 1; k <= width; ++k) {
+            Move move = FROM_DIAG;
+            cur[k] = cell(i, c0 + k, prev[k], cur[k - 1], prev[k - 1], move);
+            if (moves != nullptr) moves->set(i, c0 + k, move);
+        }
+        // The row just finished becomes `prev`; its last cell is the right edge
+        left[i - r0] = cur[width];
+        std::swap(prev, cur);
+    }
+    left[0] = corner;
+    if (prev != top) std::copy(prev, prev + width + 1, top);
+}
+
+template <typename T, typename Boundary, typename Cell>
+T solveTiles(int rows, int cols, Boundary& boundary, Cell& cell, const Options& options,
+                MoveTable* moves) {
+    if (rows == 0 || cols == 0) return boundary(rows, cols);
+    const int tile = std::max(4, (options.tileSize + 3) / 4 * 4);
+    const int tileRows = (rows + tile - 1) / tile;
+    const int tileCols = (cols + tile - 1) / tile;
+
+    // Row edges for each tile column and column edges for each tile row
+    std::vector<T> rowEdge(static_cast<size_t>(tileCols) * (tile + 1));
+    std::vector<T> colEdge(static_cast<size_t>(tileRows) * (tile + 1));
+    for (int J = 0; J < tileCols; ++J) {
+        for (int k = 0; k <= tile && J * tile + k <= cols; ++k) {
+            rowEdge[J * (tile + 1) + k] = boundary(0, J * tile + k);
+        }
+    }
+    for (int I = 0; I < tileRows; ++I) {
+        for (int k = 0; k <= tile && I * tile + k <= rows; ++k) {
+            colEdge[I * (tile + 1) + k] = boundary(I * tile + k, 0);
+        }
+    }
+
+    auto runTile = [&](int I, int J, std::vector<T>& scratch) {
+        const int r0 = I * tile, r1 = std::min(rows, r0 + tile);
+        const int c0 = J * tile, c1 = std::min(cols, c0 + tile);
+        T* top = &rowEdge[J * (tile + 1)];
+        T* left = &colEdge[I * (tile + 1)];
+        computeTile(r0, r1, c0, c1, top, left, scratch, cell, moves);
+    };
+
+    const int threads = std::max(1, std::min(options.threads, std::min(tileRows, tileCols)));
+    if (threads == 1) {
+        std::vector<T> scratch;
+        for (int I = 0; I < tileRows; ++I) {
+            for (int J = 0; J < tileCols; ++J) runTile(I, J, scratch);
+        }
+    } else {
+        // Diagonal d holds tiles (I, d - I). Every thread claims tiles from a shared
+        // counter, then all meet at the barrier before the next diagonal starts.
+        const int diagonals = tileRows + tileCols - 1;
+        std::vector<std::atomic<int>> next(diagonals);
+        for (std::atomic<int>& n : next) n.store(0);
+        Barrier barrier(threads);
+        auto worker = [&]() {
+            std::vector<T> scratch;
+            for (int d = 0; d < diagonals; ++d) {
+                const int firstI = std::max(0, d - tileCols + 1);
+                const int lastI = std::min(d, tileRows - 1);
+                for (int I = firstI + next[d]++; I <= lastI; I = firstI + next[d]++) {
+                    runTile(I, d - I, scratch);
+                }
+                barrier.arriveAndWait();
+            }
+        };
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (std::thread& t : pool) t.join();
+    }
+    const int lastCol = cols - (tileCols - 1) * tile;
+    return rowEdge[(tileCols - 1) * (tile + 1) + lastCol];
+}
+
+// Entry point: run the tiles, then follow the stored moves back from the corner
+template <typename T, typename Boundary, typename Cell>
+Result<T> solve(int rows, int cols, Boundary boundary, Cell cell, Options options) {
+    Result<T> result;
+    if (rows < 0 || cols < 0) {
+        std::cerr << "Error: Invalid grid size\n";
+        return result;
+    }
+    MoveTable table;
+    MoveTable* moves = nullptr;
+    if (options.traceback) {
+        table.reset(rows, cols);
+        moves = &table;
+    }
+    result.value = solveTiles<T>(rows, cols, boundary, cell, options, moves);
+
+    if (moves != nullptr) {
+        // Boundary cells step straight towards (0, 0)
+        int i = rows, j = cols;
+        while (i > 0 || j > 0) {
+            Move move = i == 0 ? FROM_LEFT : j == 0 ? FROM_UP : moves->get(i, j);
+            result.path.push_back(move);
+            if (move != FROM_LEFT) --i;
+            if (move != FROM_UP) --j;
+        }
+        std::reverse(result.path.begin(), result.path.end());
+    }
+    return result;
+}
+} // namespace DPGrid
+
+// === Simulated Header File: dp_problems.hpp ===
+#ifndef DP_PROBLEMS_HPP
+#define DP_PROBLEMS_HPP
+
+namespace DPProblems {
+const long long MOD = 1000000007LL;
+
+// LeetCode #62: paths from the top-left to the bottom-right moving right/down (mod 1e9+7)
+long long uniquePaths(int m, int n, DPGrid::Options options = DPGrid::Options()) {
+    auto boundary = [](int i, int j) { return i == 0 && j == 1 ? 1LL : 0LL; };
+    auto cell = [](int, int, const long long& up, const long long& left, const long long&,
+                   DPGrid::Move& move) {
+        move = DPGrid::FROM_UP;
+        return (up + left) % MOD;
+    };
+    return DPGrid::solve<long long>(m, n, boundary, cell, options).value;
+}
+
+// LeetCode #64 over a generated cost grid cost(i, j), 0-based, never stored
+template <typename Cost>
+DPGrid::Result<long long> minPathSum(int m, int n, Cost cost,
+                                     DPGrid::Options options = DPGrid::Options()) {
+    const long long INF = LLONG_MAX / 4;
+    auto boundary = [=](int i, int j) { return i == 0 && j == 1 ? 0LL : INF; };
+    auto cell = [&](int i, int j, const long long& up, const long long& left, const long long&,
+                    DPGrid::Move& move) {
+        move = up <= left ? DPGrid::FROM_UP : DPGrid::FROM_LEFT;
+        return std::min(up, left) + cost(i - 1, j - 1);
+    };
+    return DPGrid::solve<long long>(m, n, boundary, cell, options);
+}
+
+// LeetCode #72: Levenshtein distance
+DPGrid::Result<int> editDistance(const std::string& a, const std::string& b,
+                                 DPGrid::Options options = DPGrid::Options()) {
+    auto boundary = [](int i, int j) { return i + j; };
+    auto cell = [&](int i, int j, const int& up, const int& left, const int& diag,
+                    DPGrid::Move& move) {
+        if (a[i - 1] == b[j - 1]) {
+            move = DPGrid::FROM_DIAG;
+            return diag;
+        }
+        int best = diag;
+        move = DPGrid::FROM_DIAG;
+        if (up < best) { best = up; move = DPGrid::FROM_UP; }
+        if (left < best) { best = left; move = DPGrid::FROM_LEFT; }
+        return best + 1;
+    };
+    return DPGrid::solve<int>(static_cast<int>(a.size()), static_cast<int>(b.size()), boundary,
+                              cell, options);
+}
+
+// LeetCode #1143: longest common subsequence
+DPGrid::Result<int> longestCommonSubsequence(const std::string& a, const std::string& b,
+                                             DPGrid::Options options = DPGrid::Options()) {
+    auto boundary = [](int, int) { return 0; };
+    auto cell = [&](int i, int j, const int& up, const int& left, const int& diag,
+                    DPGrid::Move& move) {
+        if (a[i - 1] == b[j - 1]) {
+            move = DPGrid::FROM_DIAG;
+            return diag + 1;
+        }
+        move = up >= left ? DPGrid::FROM_UP : DPGrid::FROM_LEFT;
+        return std::max(up, left);
+    };
+    return DPGrid::solve<int>(static_cast<int>(a.size()), static_cast<int>(b.size()), boundary,
+                              cell, options);
+}
+} // namespace DPProblems
+
+#endif // DP_PROBLEMS_HPP
+
+// === Utility Functions ===
+// Textbook full-table edit distance, used to check the engine
+int naiveEditDistance(const std::string& a, const std::string& b) {
+    std::vector<std::vector<int>> dp(a.size() + 1, std::vector<int>(b.size() + 1));
+    for (size_t i = 0; i <= a.size(); ++i) {
+        for (size_t j = 0; j <= b.size(); ++j) {
+            if (i == 0 || j == 0) {
+                dp[i][j] = static_cast<int>(i + j);
+            } else if (a[i - 1] == b[j - 1]) {
+                dp[i][j] = dp[i - 1][j - 1];
+            } else {
+                dp[i][j] = 1 + std::min({dp[i - 1][j], dp[i][j - 1], dp[i - 1][j - 1]});
+            }
+        }
+    }
+    return dp[a.size()][b.size()];
+}
+
+// Textbook full-table LCS
+int naiveLcs(const std::string& a, const std::string& b) {
+    std::vector<std::vector<int>> dp(a.size() + 1, std::vector<int>(b.size() + 1, 0));
+    for (size_t i = 1; i <= a.size(); ++i) {
+        for (size_t j = 1; j <= b.size(); ++j) {
+            dp[i][j] = a[i - 1] == b[j - 1] ? dp[i - 1][j - 1] + 1
+                                            : std::max(dp[i - 1][j], dp[i][j - 1]);
+        }
+    }
+    return dp[a.size()][b.size()];
+}
+
+// Textbook full-table minimum path sum over cost[i][j]
+long long naiveMinPathSum(const std::vector<std::vector<int>>& cost) {
+    const size_t m = cost.size(), n = cost[0].size();
+    std::vector<std::vector<long long>> dp(m, std::vector<long long>(n));
+    for (size_t i = 0; i < m; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            long long best = i == 0 && j == 0 ? 0 : LLONG_MAX;
+            if (i > 0) best = std::min(best, dp[i - 1][j]);
+            if (j > 0) best = std::min(best, dp[i][j - 1]);
+            dp[i][j] = best + cost[i][j];
+        }
+    }
+    return dp[m - 1][n - 1];
+}
+
+// Pascal's triangle, mod 1e9+7
+long long naiveUniquePaths(int m, int n) {
+    std::vector<std::vector<long long>> dp(m, std::vector<long long>(n, 1));
+    for (int i = 1; i < m; ++i) {
+        for (int j = 1; j < n; ++j) dp[i][j] = (dp[i - 1][j] + dp[i][j - 1]) % DPProblems::MOD;
+    }
+    return dp[m - 1][n - 1];
+}
+
+// Random string over a small alphabet
+std::string randomString(int length, std::mt19937& rng) {
+    std::uniform_int_distribution<int> letter(0, 3);
+    std::string s(length, 'a');
+    for (char& c : s) c = static_cast<char>('a' + letter(rng));
+    return s;
+}
+
+// Apply an edit-distance path to `a` and check it produces `b` with the promised cost
+bool checkAlignment(const std::string& a, const std::string& b,
+                    const DPGrid::Result<int>& result) {
+    int i = 0, j = 0, cost = 0;
+    for (DPGrid::Move move : result.path) {
+        if (move == DPGrid::FROM_DIAG) {
+            cost += a[i] != b[j];
+            ++i;
+            ++j;
+        } else if (move == DPGrid::FROM_UP) {
+            ++cost;
+            ++i;
+        } else {
+            ++cost;
+            ++j;
+        }
+    }
+    return i == static_cast<int>(a.size()) && j == static_cast<int>(b.size()) &&
+           cost == result.value;
+}
+
+// Follow an LCS path: every diagonal step must match, and their count is the length
+bool checkLcsPath(const std::string& a, const std::string& b, const DPGrid::Result<int>& result) {
+    int i = 0, j = 0, matched = 0;
+    for (DPGrid::Move move : result.path) {
+        if (move == DPGrid::FROM_DIAG) {
+            if (a[i] != b[j]) return false;
+            ++matched;
+            ++i;
+            ++j;
+        } else if (move == DPGrid::FROM_UP) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return i == static_cast<int>(a.size()) && j == static_cast<int>(b.size()) &&
+           matched == result.value;
+}
+
+// Follow a min-path-sum path: it enters at (0, 1), stays inside the grid and adds up
+bool checkMinPath(const std::vector<std::vector<int>>& cost,
+                  const DPGrid::Result<long long>& result) {
+    int i = 0, j = 0;
+    long long total = 0;
+    for (size_t step = 0; step < result.path.size(); ++step) {
+        if (result.path[step] == DPGrid::FROM_UP) ++i;
+        else if (result.path[step] == DPGrid::FROM_LEFT) ++j;
+        else return false;
+        if (step == 0 && (i != 0 || j != 1)) return false;
+        if (step > 0) total += cost[i - 1][j - 1];
+    }
+    return i == static_cast<int>(cost.size()) && j == static_cast<int>(cost[0].size()) &&
+           total == result.value;
+}
+
+// === Program Design: Main Function ===
+int main(int argc, char* argv[]) {
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    bool ok = true;
+
+    std::cout << "=== Classic problems ===\n";
+    std::cout << "uniquePaths(3, 7) = " << DPProblems::uniquePaths(3, 7) << "\n";
+    DPGrid::Options withPath;
+    withPath.traceback = true;
+    auto grid = [](int i, int j) {
+        static const int cost[3][3] = {{1, 3, 1}, {1, 5, 1}, {4, 2, 1}};
+        return cost[i][j];
+    };
+    DPGrid::Result<long long> pathSum = DPProblems::minPathSum(3, 3, grid, withPath);
+    std::cout << "minPathSum([[1,3,1],[1,5,1],[4,2,1]]) = " << pathSum.value << ", path:";
+    for (DPGrid::Move move : pathSum.path) std::cout << (move == DPGrid::FROM_UP ? " down" : " right");
+    std::cout << "\n";
+    std::cout << "editDistance(horse, ros) = "
+              << DPProblems::editDistance("horse", "ros").value << "\n";
+    std::cout << "LCS(abcde, ace) = "
+              << DPProblems::longestCommonSubsequence("abcde", "ace").value << "\n";
+    ok = ok && DPProblems::uniquePaths(3, 7) == 28 && pathSum.value == 7 &&
+         DPProblems::editDistance("horse", "ros").value == 3 &&
+         DPProblems::longestCommonSubsequence("abcde", "ace").value == 3;
+
+    std::cout << "\n=== Engine vs full table (random sizes, tiles and threads) ===\n";
+    std::mt19937 rng(6);
+    std::uniform_int_distribution<int> lengthDist(0, 300);
+    bool editOk = true, lcsOk = true, pathSumOk = true, pathsOk = true;
+    std::uniform_int_distribution<int> costDist(0, 9);
+    for (int trial = 0; trial < 60; ++trial) {
+        std::string a = randomString(lengthDist(rng), rng);
+        std::string b = randomString(lengthDist(rng), rng);
+        DPGrid::Options options;
+        options.tileSize = 4 + trial % 5 * 17;
+        options.threads = 1 + trial % 4;
+        options.traceback = trial % 2 == 0;
+        DPGrid::Result<int> edit = DPProblems::editDistance(a, b, options);
+        editOk = editOk && edit.value == naiveEditDistance(a, b) &&
+                 (!options.traceback || checkAlignment(a, b, edit));
+        DPGrid::Result<int> lcs = DPProblems::longestCommonSubsequence(a, b, options);
+        lcsOk = lcsOk && lcs.value == naiveLcs(a, b) &&
+                (!options.traceback || checkLcsPath(a, b, lcs));
+
+        const int m = 1 + static_cast<int>(a.size()), n = 1 + static_cast<int>(b.size());
+        std::vector<std::vector<int>> cost(m, std::vector<int>(n));
+        for (std::vector<int>& row : cost) {
+            for (int& c : row) c = costDist(rng);
+        }
+        DPGrid::Result<long long> sum =
+            DPProblems::minPathSum(m, n, [&](int i, int j) { return cost[i][j]; }, options);
+        pathSumOk = pathSumOk && sum.value == naiveMinPathSum(cost) &&
+                    (!options.traceback || checkMinPath(cost, sum));
+        pathsOk = pathsOk && DPProblems::uniquePaths(m, n, options) == naiveUniquePaths(m, n);
+    }
+    std::cout << "edit distance: " << (editOk ? "pass" : "FAIL") << "\n";
+    std::cout << "LCS:           " << (lcsOk ? "pass" : "FAIL") << "\n";
+    std::cout << "minPathSum:    " << (pathSumOk ? "pass" : "FAIL") << "\n";
+    std::cout << "uniquePaths:   " << (pathsOk ? "pass" : "FAIL") << "\n";
+    ok = ok && editOk && lcsOk && pathSumOk && pathsOk;
+
+    // Large run: O(rows + cols) memory regardless of the grid size
+    const int n = argc > 1 ? std::atoi(argv[1]) : 20000;
+    std::string a = randomString(n, rng), b = randomString(n, rng);
+    std::cout << "\n=== Edit distance, " << n << " x " << n << " ===\n";
+    int reference = -1;
+    for (int threads = 1;; threads = std::min(threads * 2, hardware)) {
+        DPGrid::Options options;
+        options.threads = threads;
+        auto start = std::chrono::steady_clock::now();
+        int distance = DPProblems::editDistance(a, b, options).value;
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (reference < 0) reference = distance;
+        ok = ok && distance == reference;
+        std::cout << threads << " thread(s): distance " << distance << ", " << elapsed.count()
+                  << " s, " << 1e-9 * n * n / elapsed.count() << " Gcells/s\n";
+        if (threads == hardware) break;
+    }
+    return ok ? 0 : 1;
+}
+
+// === Program Design Notes ===
+// - Without traceback the engine holds two edge arrays of (rows + cols + tiles) values plus
+//   one tile row per thread; a 50k x 50k grid therefore needs well under a megabyte.
+// - Traceback costs 2 bits per cell (about 600 MB at 50k x 50k); for paths on grids that
+//   large, Hirschberg's divide-and-conquer on top of solve() is the next step.
+// - The tile size trades cache fit against diagonal length: smaller tiles mean more
+//   parallel work per diagonal but more barrier waits.
+
+// === End of File ===